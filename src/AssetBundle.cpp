@@ -0,0 +1,40 @@
+#include "AssetBundle.h"
+#include "raylib.h"
+#include "AssetCache.h"
+
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+
+static void onBundleScriptError()
+{
+    TraceLog(LOG_WARNING, "BUNDLE: Failed to load an asset bundle script");
+}
+#endif
+
+AssetBundle::AssetBundle(const char* scriptUrl, const char* probeFile):
+    script(scriptUrl),
+    probe(probeFile)
+{
+#if !defined(PLATFORM_WEB)
+    ready = true;
+#endif
+}
+
+void AssetBundle::request()
+{
+    if (requested)
+        return;
+    requested = true;
+#if defined(PLATFORM_WEB)
+    emscripten_async_load_script(script, nullptr, onBundleScriptError);
+#endif
+}
+
+bool AssetBundle::isReady()
+{
+    // file_packager creates all of a bundle's files at once, after its data
+    // has arrived, so one of them showing up means the whole bundle is there
+    if (!ready && requested)
+        ready = FileExists(AssetCache::resolvePath(probe).c_str());
+    return ready;
+}
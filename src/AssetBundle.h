@@ -0,0 +1,25 @@
+#ifndef ASSET_BUNDLE_H
+#define ASSET_BUNDLE_H
+
+// A group of asset files that is downloaded on demand in the web build
+// (see the asset manifest in the Makefile). The bundle is a file_packager
+// .data/.js pair: loading the script fetches the data and unpacks it into
+// MEMFS, where the usual Load* calls find the files. Desktop builds read
+// the files straight from disk, so there every bundle is always ready.
+class AssetBundle
+{
+public:
+    // scriptUrl: the bundle's loader script, probeFile: any file it contains
+    AssetBundle(const char* scriptUrl, const char* probeFile);
+    // start the download, only the first call does anything
+    void request();
+    // true once the bundle's files can be loaded
+    bool isReady();
+private:
+    const char* script{};
+    const char* probe{};
+    bool requested{false};
+    bool ready{false};
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "AssetCache.h"
+
+static bool replaceExtension(std::string& path, const char* from, const char* to)
+{
+    const std::string extension(from);
+    if (path.size() < extension.size() ||
+        path.compare(path.size() - extension.size(), extension.size(), extension) != 0)
+        return false;
+    path.replace(path.size() - extension.size(), extension.size(), to);
+    return true;
+}
+
+std::string AssetCache::resolvePath(const std::string& path)
+{
+    std::string converted(path);
+    if ((replaceExtension(converted, ".png", ".qoi") || replaceExtension(converted, ".wav", ".ogg")) &&
+        FileExists(converted.c_str()))
+        return converted;
+    return path;
+}
+
+TextureHandle AssetCache::getTexture(const std::string& path)
+{
+    auto& entry = textures[path];
+    if (TextureHandle texture = entry.lock())
+        return texture;
+
+    TextureHandle texture(new Texture2D(LoadTexture(resolvePath(path).c_str())), [](const Texture2D* texture) {
+        UnloadTexture(*texture);
+        delete texture;
+    });
+    entry = texture;
+    return texture;
+}
+
+SoundHandle AssetCache::getSound(const std::string& path)
+{
+    auto& entry = sounds[path];
+    if (SoundHandle sound = entry.lock())
+        return sound;
+
+    SoundHandle sound(new Sound(LoadSound(resolvePath(path).c_str())), [](const Sound* sound) {
+        UnloadSound(*sound);
+        delete sound;
+    });
+    entry = sound;
+    return sound;
+}
+
+SoundHandle AssetCache::getSoundAlias(const std::string& path)
+{
+    // the alias keeps its source loaded for as long as it lives
+    SoundHandle source = getSound(path);
+    return SoundHandle(new Sound(LoadSoundAlias(*source)), [source](const Sound* alias) {
+        UnloadSoundAlias(*alias);
+        delete alias;
+    });
+}
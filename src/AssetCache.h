@@ -0,0 +1,38 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include "raylib.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Shared handles: the asset is unloaded when the last handle goes away
+using TextureHandle = std::shared_ptr<const Texture2D>;
+using SoundHandle = std::shared_ptr<const Sound>;
+
+// Loads each texture and sound once per path and hands out shared handles.
+// Sounds that need to overlap with themselves get aliases: each alias is an
+// independent voice that plays the same decoded samples (raylib 5.0+).
+// Keep the cache and every handle alive only while the window and audio
+// device are open.
+class AssetCache
+{
+public:
+    AssetCache() = default;
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    // the converted version of path (see `make assets`) when it exists,
+    // else path itself: .png -> .qoi, .wav -> .ogg
+    static std::string resolvePath(const std::string& path);
+
+    TextureHandle getTexture(const std::string& path);
+    SoundHandle getSound(const std::string& path);
+    // a new voice sharing the sample data of getSound(path)
+    SoundHandle getSoundAlias(const std::string& path);
+private:
+    std::unordered_map<std::string, std::weak_ptr<const Texture2D>> textures;
+    std::unordered_map<std::string, std::weak_ptr<const Sound>> sounds;
+};
+
+#endif
@@ -0,0 +1,25 @@
+// Generated by tools/pack_atlas.py, do not edit. Run `make atlas` instead.
+// Source rects of every sprite packed into atlas/sprites.png.
+#ifndef ATLAS_DATA_H
+#define ATLAS_DATA_H
+
+#include "raylib.h"
+
+#define ATLAS_IMAGE_PATH "atlas/sprites.png"
+const int ATLAS_WIDTH{256};
+const int ATLAS_HEIGHT{128};
+
+const Rectangle ATLAS_GOBLIN_IDLE{46.f, 0.f, 96.f, 16.f}; // characters/goblin_idle_spritesheet.png
+const Rectangle ATLAS_GOBLIN_RUN{143.f, 0.f, 96.f, 16.f}; // characters/goblin_run_spritesheet.png
+const Rectangle ATLAS_INTELLECT_DEVOURER_IDLE_SIDE{0.f, 26.f, 96.f, 16.f}; // characters/IntellectDevourerIdleSide_spritesheet.png
+const Rectangle ATLAS_KNIGHT_IDLE{97.f, 26.f, 96.f, 16.f}; // characters/knight_idle_spritesheet.png
+const Rectangle ATLAS_KNIGHT_RUN{0.f, 43.f, 96.f, 16.f}; // characters/knight_run_spritesheet.png
+const Rectangle ATLAS_LOG{97.f, 60.f, 27.f, 16.f}; // nature_tileset/Log.png
+const Rectangle ATLAS_ROCK{23.f, 0.f, 22.f, 21.f}; // nature_tileset/Rock.png
+const Rectangle ATLAS_SIGN{0.f, 0.f, 22.f, 25.f}; // nature_tileset/Sign.png
+const Rectangle ATLAS_SLIME_IDLE{97.f, 43.f, 96.f, 16.f}; // characters/slime_idle_spritesheet.png
+const Rectangle ATLAS_SLIME_RUN{0.f, 60.f, 96.f, 16.f}; // characters/slime_run_spritesheet.png
+const Rectangle ATLAS_WEAPON_LASER_SWORD{125.f, 60.f, 16.f, 16.f}; // characters/weapon_laser_sword.png
+const Rectangle ATLAS_WEAPON_SWORD{142.f, 60.f, 16.f, 16.f}; // characters/weapon_sword.png
+
+#endif
@@ -1,17 +1,19 @@
 #include "raylib.h"
 #include "BaseCharacter.h"
 #include "raymath.h"
+#include "Timing.h"
+#include "Profiler.h"
 
 BaseCharacter::BaseCharacter()
 {
     
 }
 
-BaseCharacter::BaseCharacter(Texture2D idleTexture, Texture2D runTexture)
+BaseCharacter::BaseCharacter(float frameWidth, float frameHeight):
+    width(frameWidth),
+    height(frameHeight)
 {
-    idle = idleTexture;
-    run = runTexture;
-    texture = idle;
+
 }
 
 void BaseCharacter::undoMovement()
@@ -19,18 +21,29 @@ void BaseCharacter::undoMovement()
     worldPos = worldPosLastFrame;
 }
 
-Rectangle BaseCharacter::getCollisionRec()
+Rectangle BaseCharacter::getCollisionRec() const
 {
     return Rectangle{
         getScreenPos().x,
         getScreenPos().y,
         width * scale,
-        texture.height * scale
+        height * scale
+    };
+}
+
+Rectangle BaseCharacter::getWorldCollisionRec() const
+{
+    return Rectangle{
+        worldPos.x,
+        worldPos.y,
+        width * scale,
+        height * scale
     };
 }
 
 void BaseCharacter::tick(float deltaTime)
 {
+    PROFILE_ZONE("BaseCharacter::tick");
     worldPosLastFrame = worldPos;
 
     bool isMoving = (Vector2Length(velocity) != 0.0);
@@ -42,20 +55,17 @@ void BaseCharacter::tick(float deltaTime)
     if (isMoving)
     {
         // set worldPos = worldPos + direction
-        worldPos = Vector2Add(worldPos, Vector2Scale(Vector2Normalize(velocity), speed));
+        float distance = speed * deltaTime * SPEED_REFERENCE_RATE;
+        worldPos = Vector2Add(worldPos, Vector2Scale(Vector2Normalize(velocity), distance));
         velocity.x < 0.f ? rightLeft = -1.f : rightLeft = 1.f;
         
-        // Only change texture and reset animation if we weren't moving before
+        // Only switch sheet and reset animation if we weren't moving before
         if (!wasMoving)
         {
-            texture = run;
+            running = true;
             frame = 0;
             runningTime = 0.f;
         }
-        else 
-        {
-            texture = run;
-        }
         
         // Update animation frame only when moving
         if (runningTime >= updateTime)
@@ -69,17 +79,13 @@ void BaseCharacter::tick(float deltaTime)
     }
     else
     {
-        // Only change texture and reset animation if we were moving before
+        // Only switch sheet and reset animation if we were moving before
         if (wasMoving)
         {
-            texture = idle;
+            running = false;
             frame = 0;
             runningTime = 0.f;
         }
-        else 
-        {
-            texture = idle;
-        }
         
         // Keep idle animation running but slower
         if (runningTime >= updateTime * 3.0f) // Much slower idle animation
@@ -94,14 +100,10 @@ void BaseCharacter::tick(float deltaTime)
     
     wasMoving = isMoving;
     velocity = {};
-    
-    // draw the character with better safety checks
+
+    // keep the frame in range for the renderer
     if (frame < 0) frame = 0;
     if (frame >= maxFrames) frame = 0; // Reset to 0 if out of bounds
-    
-    Rectangle source{frame * width, 0.f, rightLeft * width, height};
-    Rectangle dest{getScreenPos().x, getScreenPos().y, scale * width, scale * height};
-    DrawTexturePro(texture, source, dest, Vector2{}, 0.f, WHITE);
 }
 
 void BaseCharacter::takeDamage(float damage)
@@ -113,3 +115,31 @@ void BaseCharacter::takeDamage(float damage)
         setAlive(false);
     }
 }
+
+void BaseCharacter::saveState(SnapshotWriter& out) const
+{
+    out.write(worldPos);
+    out.write(worldPosLastFrame);
+    out.write(rightLeft);
+    out.write(running);
+    out.write(runningTime);
+    out.write(frame);
+    out.write(velocity);
+    out.write(wasMoving);
+    out.write(health);
+    out.write(alive);
+}
+
+void BaseCharacter::loadState(SnapshotReader& in)
+{
+    in.read(worldPos);
+    in.read(worldPosLastFrame);
+    in.read(rightLeft);
+    in.read(running);
+    in.read(runningTime);
+    in.read(frame);
+    in.read(velocity);
+    in.read(wasMoving);
+    in.read(health);
+    in.read(alive);
+}
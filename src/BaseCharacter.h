@@ -1,31 +1,43 @@
 #ifndef BASE_CHARACTER_H
 #define BASE_CHARACTER_H
 #include "raylib.h"
+#include "Snapshot.h"
 
 class BaseCharacter
-{   
+{
 public:
     BaseCharacter();
-    BaseCharacter(Texture2D idleTexture, Texture2D runTexture);
-    Vector2 getWorldPos() { return worldPos; }
+    BaseCharacter(float frameWidth, float frameHeight);
+    virtual ~BaseCharacter() = default;
+    Vector2 getWorldPos() const { return worldPos; }
     void undoMovement();
-    Rectangle getCollisionRec();
+    Rectangle getCollisionRec() const;
+    // collision box in world coordinates, for the broadphase grid
+    virtual Rectangle getWorldCollisionRec() const;
     virtual void tick(float deltaTime);
-    virtual Vector2 getScreenPos() = 0;
-    bool getAlive() { return alive; }
+    virtual Vector2 getScreenPos() const = 0;
+    bool getAlive() const { return alive; }
     void setAlive(bool isAlive) { alive = isAlive; }
     float getHealth() const { return health; }
     void takeDamage(float damage);
     void setHealth(float newHealth) { health = newHealth; }
+    // animation state, read by the renderer
+    bool getRunning() const { return running; }
+    int getFrame() const { return frame; }
+    float getRightLeft() const { return rightLeft; }
+    float getWidth() const { return width; }
+    float getHeight() const { return height; }
+    float getScale() const { return scale; }
+    // every mutable field, for World snapshots
+    virtual void saveState(SnapshotWriter& out) const;
+    virtual void loadState(SnapshotReader& in);
 protected:
-    Texture2D texture{};
-    Texture2D idle{};
-    Texture2D run{};
     Vector2 worldPos{};
     Vector2 worldPosLastFrame{};
     // 1 : facing right, -1 : facing left
     float rightLeft{1.f};
     // animation variables
+    bool running{false}; // true : run sheet, false : idle sheet
     float runningTime{};
     int frame{};
     int maxFrames{6};
@@ -42,4 +54,4 @@ private:
     bool alive{ true };
 };
 
-#endif 
+#endif
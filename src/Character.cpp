@@ -1,24 +1,18 @@
 #include "Character.h"
+#include "Input.h"
+#include "SpriteData.h"
 #include "raylib.h"
 #include "raymath.h"
 
-Character::Character(int winWidth, int winHeight, Texture2D idleTexture, Texture2D runTexture):
-    BaseCharacter(idleTexture, runTexture),
+Character::Character(int winWidth, int winHeight):
+    BaseCharacter(CHARACTER_FRAME_WIDTH, CHARACTER_FRAME_HEIGHT),
     windowWidth(winWidth),
     windowHeight(winHeight)
 {
-    width = texture.width/maxFrames;
-    height = texture.height;
-
-    SetSoundVolume(stride, 0.8f);
-    SetSoundVolume(attack, 0.65f);
-    // set the tempo of the stride and the attack
-    SetSoundPitch(stride, 2.05f);
-    SetSoundPitch(attack, 1.8f);
-
+    maxFrames = CHARACTER_MAX_FRAMES;
 }
 
-Vector2 Character::getScreenPos()
+Vector2 Character::getScreenPos() const
 {
     return Vector2{
         static_cast<float>(windowWidth) / 2.0f - scale * (0.5f * width),
@@ -26,69 +20,81 @@ Vector2 Character::getScreenPos()
     };
 }
 
+Rectangle Character::getWorldCollisionRec() const
+{
+    Rectangle rec = getCollisionRec();
+    rec.x += worldPos.x;
+    rec.y += worldPos.y;
+    return rec;
+}
+
+Rectangle Character::getWorldWeaponCollisionRec() const
+{
+    Rectangle rec = weaponCollisionRec;
+    rec.x += worldPos.x;
+    rec.y += worldPos.y;
+    return rec;
+}
+
+bool Character::isStriding() const
+{
+    return (input & INPUT_MOVE_MASK) != 0;
+}
+
+bool Character::isAttacking() const
+{
+    return (input & INPUT_ATTACK) != 0;
+}
+
 void Character::tick(float deltaTime)
 {
     if (!getAlive()) return;
 
-    if (IsKeyDown(KEY_A))
+    if (input & INPUT_LEFT)
         velocity.x -= 1.0;
-    if (IsKeyDown(KEY_D))
+    if (input & INPUT_RIGHT)
         velocity.x += 1.0;
-    if (IsKeyDown(KEY_W))
+    if (input & INPUT_UP)
         velocity.y -= 1.0;
-    if (IsKeyDown(KEY_S))
+    if (input & INPUT_DOWN)
         velocity.y += 1.0;
-        
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_D) || IsKeyDown(KEY_W) || IsKeyDown(KEY_S))
-    {
-        if (!IsSoundPlaying(stride))
-            PlaySound(stride);
-        else
-            ResumeSound(stride);
-    }
-    
+
     BaseCharacter::tick(deltaTime);
 
-    Vector2 origin{};
     Vector2 offset{};
-    float rotation{};
-    
+
     if (rightLeft > 0.f)
     {
-        origin = {0.f, weapon.height * scale};
         offset = {45.f, 70.f};
         weaponCollisionRec = {
             getScreenPos().x + offset.x,
-            getScreenPos().y + offset.y - weapon.height * scale,
-            weapon.width * scale,
-            weapon.height * scale
+            getScreenPos().y + offset.y - WEAPON_HEIGHT * scale,
+            WEAPON_WIDTH * scale,
+            WEAPON_HEIGHT * scale
         };
-        rotation = IsKeyDown(KEY_SPACE) ? 35.f : 0.f;
     }
     else
     {
-        origin = {weapon.width * scale, weapon.height * scale};
         offset = {35.f, 70.f};
         weaponCollisionRec = {
-            getScreenPos().x + offset.x - weapon.width * scale,
-            getScreenPos().y + offset.y - weapon.height * scale,
-            weapon.width * scale,
-            weapon.height * scale
+            getScreenPos().x + offset.x - WEAPON_WIDTH * scale,
+            getScreenPos().y + offset.y - WEAPON_HEIGHT * scale,
+            WEAPON_WIDTH * scale,
+            WEAPON_HEIGHT * scale
         };
-        rotation = IsKeyDown(KEY_SPACE) ? -35.f : 0.f;
     }
+}
 
-    if (IsKeyDown(KEY_SPACE))
-    {
-        if (!IsSoundPlaying(attack))
-            PlaySound(attack);
-        else
-            ResumeSound(attack);
-    }
-    
-    // draw the sworde
-    Rectangle source{0.f, 0.f, static_cast<float>(weapon.width) * rightLeft, static_cast<float>(weapon.height)};
-    Rectangle dest{getScreenPos().x + offset.x, getScreenPos().y + offset.y, weapon.width * 3.f, weapon.height * 3.f};
-    DrawTexturePro(weapon, source, dest, origin, rotation, WHITE);
+void Character::saveState(SnapshotWriter& out) const
+{
+    BaseCharacter::saveState(out);
+    out.write(weaponCollisionRec);
+    out.write(input);
 }
 
+void Character::loadState(SnapshotReader& in)
+{
+    BaseCharacter::loadState(in);
+    in.read(weaponCollisionRec);
+    in.read(input);
+}
@@ -7,17 +7,25 @@
 class Character : public BaseCharacter
 {
 public:
-    Character(int winWidth, int winHeight, Texture2D idleTexture, Texture2D runTexture);
+    Character(int winWidth, int winHeight);
     virtual void tick(float deltaTime) override;
-    virtual Vector2 getScreenPos() override;
-    Rectangle getWeaponCollisionRec() { return weaponCollisionRec; }
+    virtual Vector2 getScreenPos() const override;
+    // the knight's worldPos is the camera offset, the sprite sits at screen center
+    virtual Rectangle getWorldCollisionRec() const override;
+    Rectangle getWeaponCollisionRec() const { return weaponCollisionRec; }
+    Rectangle getWorldWeaponCollisionRec() const;
+    void setInput(unsigned buttons) { input = buttons; }
+    // a movement button is held (stride sound)
+    bool isStriding() const;
+    bool isAttacking() const;
+    virtual void saveState(SnapshotWriter& out) const override;
+    virtual void loadState(SnapshotReader& in) override;
 private:
     int windowWidth{};
     int windowHeight{};
-    Texture2D weapon{LoadTexture("characters/weapon_laser_sword.png")};
     Rectangle weaponCollisionRec{};
-    Sound stride = LoadSound("nature_tileset/16_human_walk_stone_3.wav");
-    Sound attack = LoadSound("nature_tileset/07_human_atk_sword_2.wav");
+    // InputButton bits for the current tick
+    unsigned input{};
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,14 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "raylib.h"
+
+// Same test as raylib's CheckCollisionRecs, kept inline so the simulation
+// does not have to link raylib (see the headless build in the Makefile).
+inline bool recsOverlap(Rectangle a, Rectangle b)
+{
+    return (a.x < (b.x + b.width) && (a.x + a.width) > b.x) &&
+           (a.y < (b.y + b.height) && (a.y + a.height) > b.y);
+}
+
+#endif
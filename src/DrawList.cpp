@@ -0,0 +1,46 @@
+#include "DrawList.h"
+#include <algorithm>
+
+void DrawList::clear()
+{
+    // keep the capacity, the list is refilled every frame
+    commands.clear();
+}
+
+void DrawList::push(DrawLayer layer, Texture2D texture, Rectangle source, Rectangle dest,
+                    Vector2 origin, float rotation)
+{
+    SpriteCommand command{};
+    command.texture = texture;
+    command.source = source;
+    command.dest = dest;
+    command.origin = origin;
+    command.rotation = rotation;
+    // 8 bits layer | 24 bits texture id | 32 bits order, so sprites sharing
+    // a layer and texture keep the order they were pushed in
+    command.key = (static_cast<unsigned long long>(layer) << 56) |
+                  (static_cast<unsigned long long>(texture.id & 0xFFFFFFu) << 32) |
+                  static_cast<unsigned long long>(commands.size());
+    commands.push_back(command);
+}
+
+void DrawList::sort()
+{
+    std::sort(commands.begin(), commands.end(),
+              [](const SpriteCommand& a, const SpriteCommand& b) { return a.key < b.key; });
+}
+
+void DrawList::submit()
+{
+    textureSwitches = 0;
+    unsigned int boundTexture{0};
+    for (const auto& command : commands)
+    {
+        if (command.texture.id != boundTexture)
+        {
+            boundTexture = command.texture.id;
+            textureSwitches++;
+        }
+        DrawTexturePro(command.texture, command.source, command.dest, command.origin, command.rotation, WHITE);
+    }
+}
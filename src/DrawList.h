@@ -0,0 +1,46 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include "raylib.h"
+#include <vector>
+
+// Draw order between groups of sprites; lower layers are drawn first
+enum DrawLayer
+{
+    LAYER_MAP,
+    LAYER_PROPS,
+    LAYER_CHARACTERS,
+    LAYER_WEAPON
+};
+
+struct SpriteCommand
+{
+    Texture2D texture{};
+    Rectangle source{};
+    Rectangle dest{};
+    Vector2 origin{};
+    float rotation{};
+    // layer, texture id and submission order packed so one sort orders all three
+    unsigned long long key{};
+};
+
+// Sprites gathered during the render pass, sorted by layer then texture
+// before submission so each texture is bound once per layer instead of
+// once per entity. raylib batches consecutive quads that share a texture.
+class DrawList
+{
+public:
+    void clear();
+    void push(DrawLayer layer, Texture2D texture, Rectangle source, Rectangle dest,
+              Vector2 origin = Vector2{}, float rotation = 0.f);
+    void sort();
+    void submit();
+    int size() const { return static_cast<int>(commands.size()); }
+    // texture changes during the last submit()
+    int getTextureSwitches() const { return textureSwitches; }
+private:
+    std::vector<SpriteCommand> commands;
+    int textureSwitches{};
+};
+
+#endif
@@ -1,9 +1,18 @@
 #include "DynamicScreen.h"
 
-DynamicScreen::DynamicScreen()
+const char* const PROMPT_TEXT{"Press Enter To Start"};
+const int PROMPT_FONT_SIZE{33};
+
+DynamicScreen::DynamicScreen(AssetCache& assets):
+    startScreenTile(assets.getTexture("nature_tileset/dune_globe.png")),
+    prompt(MeasureText(PROMPT_TEXT, PROMPT_FONT_SIZE), PROMPT_FONT_SIZE)
 {
-    width = static_cast<float>(startScreenTile.width / maxFrames);
-    height = static_cast<float>(startScreenTile.height / maxTileLines);
+    width = static_cast<float>(startScreenTile->width / maxFrames);
+    height = static_cast<float>(startScreenTile->height / maxTileLines);
+
+    prompt.begin();
+    DrawText(PROMPT_TEXT, 0, 0, PROMPT_FONT_SIZE, WHITE);
+    prompt.end();
 }
 
 void DynamicScreen::Tick(float deltaTime, Vector2 mapPos)
@@ -24,7 +33,7 @@ void DynamicScreen::Tick(float deltaTime, Vector2 mapPos)
 
     Rectangle source{frameRow * width, frameLine * height, width, height};
     Rectangle dest{mapPos.x + 95, mapPos.y + 30, width * 1.7f, height * 1.7f};
-    DrawTexturePro(startScreenTile, source, dest, Vector2{}, 0.f, WHITE);
+    DrawTexturePro(*startScreenTile, source, dest, Vector2{}, 0.f, WHITE);
 
-    DrawText("Press Enter To Start", 160.f, 180.f, 33, WHITE);
+    prompt.draw(Vector2{160.f, 180.f});
 }
\ No newline at end of file
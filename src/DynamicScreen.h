@@ -1,9 +1,11 @@
 #include "raylib.h"
+#include "AssetCache.h"
+#include "UiLayer.h"
 
 class DynamicScreen
 {
 private:
-    Texture2D startScreenTile = LoadTexture("nature_tileset/dune_globe.png");
+    TextureHandle startScreenTile;
     float runningTime{};
     int frameRow{};
     int frameLine{};
@@ -12,7 +14,9 @@ private:
     float updateTime{1.f / 18.f};
     float width{};
     float height{};
+    // "Press Enter To Start", drawn once
+    UiLayer prompt;
 public:
-    DynamicScreen();
+    explicit DynamicScreen(AssetCache& assets);
     void Tick(float deltaTime, Vector2 mapPos);
 };
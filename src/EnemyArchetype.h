@@ -0,0 +1,36 @@
+#ifndef ENEMY_ARCHETYPE_H
+#define ENEMY_ARCHETYPE_H
+
+// Stats and steering behaviour shared by every enemy of one type. The table
+// is constexpr, so EnemyPool's per-archetype update loops (one template
+// instance each) see these as constants and carry no type checks.
+struct EnemyArchetype
+{
+    float maxHealth;
+    float damagePerSec;
+    // body radius; the steering distances are multiples of it (Steering.h)
+    float radius;
+    float stopRadiusScale;
+    // 0 : never circles the knight
+    float circleRadiusScale;
+
+    constexpr float stopRadius() const { return radius * stopRadiusScale; }
+    constexpr float circleRadius() const { return radius * circleRadiusScale; }
+};
+
+// One entry per EnemyPool::EnemyType, in the same order. A new kind of enemy
+// is a new row here plus its enum value (and its sprites in Renderer.cpp).
+constexpr EnemyArchetype ENEMY_ARCHETYPES[]{
+    // GOBLIN
+    {100.f, 12.f, 25.f, 1.f, 0.f},
+    // SLIME: stops further away and moves more cautiously
+    {60.f, 8.f, 20.f, 1.2f, 0.f},
+    // INTELLECT_DEVOURER: more aggressive, gets closer
+    {180.f, 20.f, 35.f, 0.8f, 0.f},
+    // ELITE_GOBLIN: circles around the player sometimes
+    {150.f, 18.f, 30.f, 1.f, 1.5f},
+    // SLIME_KING
+    {120.f, 15.f, 28.f, 1.2f, 0.f},
+};
+
+#endif
@@ -0,0 +1,611 @@
+#include "EnemyPool.h"
+#include "Collision.h"
+#include "FlowField.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "SpriteData.h"
+#include "Steering.h"
+#include "Timing.h"
+#include <algorithm>
+#include <cmath>
+
+const float ENEMY_SCALE{4.f};
+const float ENEMY_HALF_SIZE{CHARACTER_FRAME_WIDTH * ENEMY_SCALE * 0.5f};
+const float ENEMY_UPDATE_TIME{1.f / 12.f};
+// enemies per job. Fixed (not derived from the thread count) so the chunks,
+// and with them the order damage is summed in, are the same on every machine
+const int ENEMY_CHUNK_SIZE{256};
+// up to this many chunks run on the caller: a chunk takes a few
+// microseconds, about what waking the workers for it costs
+const int ENEMY_INLINE_CHUNKS{8};
+// AI level of detail, squared distances from the knight (enemy top-left
+// to knight screen position, as in Steering). Near covers the screen with
+// a margin and updates every step; mid-range enemies update every
+// AI_MID_INTERVAL steps; past the sleep distance they sleep until the
+// knight is back inside the (smaller) wake distance
+const float AI_NEAR_DISTANCE_SQ{800.f * 800.f};
+const float AI_SLEEP_DISTANCE_SQ{2000.f * 2000.f};
+const float AI_WAKE_DISTANCE_SQ{1800.f * 1800.f};
+const unsigned int AI_MID_INTERVAL{4};
+// how far ahead of its centre an enemy looks for props in its way
+const float FLOW_LOOKAHEAD{48.f};
+
+static_assert(sizeof(ENEMY_ARCHETYPES) / sizeof(ENEMY_ARCHETYPES[0]) == EnemyPool::ENEMY_TYPE_COUNT,
+              "one ENEMY_ARCHETYPES entry per EnemyType");
+
+void EnemyPool::reserve(int capacity)
+{
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    lastX.reserve(capacity);
+    lastY.reserve(capacity);
+    prevX.reserve(capacity);
+    prevY.reserve(capacity);
+    health.reserve(capacity);
+    speed.reserve(capacity);
+    type.reserve(capacity);
+    rightLeft.reserve(capacity);
+    runningTime.reserve(capacity);
+    frame.reserve(capacity);
+    running.reserve(capacity);
+    wasMoving.reserve(capacity);
+    gridId.reserve(capacity);
+    level.reserve(capacity);
+    lastTick.reserve(capacity);
+    handle.reserve(capacity);
+    handles.reserve(capacity);
+    chunks.reserve(capacity / ENEMY_CHUNK_SIZE + ENEMY_TYPE_COUNT);
+    // slots below capacity spread evenly over the buckets
+    for (auto& bucket : sleepBuckets)
+        bucket.reserve((capacity + SLEEP_BUCKET_COUNT - 1) / SLEEP_BUCKET_COUNT);
+}
+
+// copy every array's element from one index to another
+void EnemyPool::moveEnemy(int from, int to)
+{
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    lastX[to] = lastX[from];
+    lastY[to] = lastY[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    health[to] = health[from];
+    speed[to] = speed[from];
+    type[to] = type[from];
+    rightLeft[to] = rightLeft[from];
+    runningTime[to] = runningTime[from];
+    frame[to] = frame[from];
+    running[to] = running[from];
+    wasMoving[to] = wasMoving[from];
+    gridId[to] = gridId[from];
+    level[to] = level[from];
+    lastTick[to] = lastTick[from];
+    handle[to] = handle[from];
+    handles.setDenseIndex(handle[to], to);
+}
+
+void EnemyPool::swapEnemies(int a, int b)
+{
+    std::swap(posX[a], posX[b]);
+    std::swap(posY[a], posY[b]);
+    std::swap(lastX[a], lastX[b]);
+    std::swap(lastY[a], lastY[b]);
+    std::swap(prevX[a], prevX[b]);
+    std::swap(prevY[a], prevY[b]);
+    std::swap(health[a], health[b]);
+    std::swap(speed[a], speed[b]);
+    std::swap(type[a], type[b]);
+    std::swap(rightLeft[a], rightLeft[b]);
+    std::swap(runningTime[a], runningTime[b]);
+    std::swap(frame[a], frame[b]);
+    std::swap(running[a], running[b]);
+    std::swap(wasMoving[a], wasMoving[b]);
+    std::swap(gridId[a], gridId[b]);
+    std::swap(level[a], level[b]);
+    std::swap(lastTick[a], lastTick[b]);
+    std::swap(handle[a], handle[b]);
+    handles.setDenseIndex(handle[a], a);
+    handles.setDenseIndex(handle[b], b);
+}
+
+int EnemyPool::add(Vector2 pos, float enemySpeed, EnemyType enemyType)
+{
+    // grow by one, then walk the hole at the end down to the end of this
+    // type's group: each later group gives its first sleeper and its first
+    // awake enemy one place on and starts one index later
+    int hole = size();
+    posX.push_back(0.f);
+    posY.push_back(0.f);
+    lastX.push_back(0.f);
+    lastY.push_back(0.f);
+    prevX.push_back(0.f);
+    prevY.push_back(0.f);
+    health.push_back(0.f);
+    speed.push_back(0.f);
+    type.push_back(0);
+    rightLeft.push_back(0.f);
+    runningTime.push_back(0.f);
+    frame.push_back(0);
+    running.push_back(0);
+    wasMoving.push_back(0);
+    gridId.push_back(-1);
+    level.push_back(AI_NEAR);
+    lastTick.push_back(0);
+    handle.push_back(EntityHandle{});
+    groupStart[ENEMY_TYPE_COUNT]++;
+
+    for (int group = ENEMY_TYPE_COUNT - 1; group > enemyType; group--)
+    {
+        int first = groupStart[group];
+        int firstAsleep = asleepStart[group];
+        if (firstAsleep != hole)
+            moveEnemy(firstAsleep, hole);
+        if (first != firstAsleep)
+            moveEnemy(first, firstAsleep);
+        hole = first;
+        groupStart[group]++;
+        asleepStart[group]++;
+    }
+
+    // new enemies start awake, ahead of the group's sleepers
+    int firstAsleep = asleepStart[enemyType];
+    if (firstAsleep != hole)
+        moveEnemy(firstAsleep, hole);
+    hole = firstAsleep;
+    asleepStart[enemyType]++;
+
+    const EnemyArchetype& archetype = ENEMY_ARCHETYPES[enemyType];
+    posX[hole] = pos.x;
+    posY[hole] = pos.y;
+    lastX[hole] = pos.x;
+    lastY[hole] = pos.y;
+    prevX[hole] = pos.x;
+    prevY[hole] = pos.y;
+    health[hole] = archetype.maxHealth;
+    speed[hole] = enemySpeed;
+    type[hole] = static_cast<unsigned char>(enemyType);
+    rightLeft[hole] = 1.f;
+    runningTime[hole] = 0.f;
+    frame[hole] = 0;
+    running[hole] = 0;
+    wasMoving[hole] = 0;
+    gridId[hole] = -1;
+    level[hole] = AI_NEAR;
+    lastTick[hole] = tickCount;
+    handle[hole] = handles.create(hole);
+    return hole;
+}
+
+void EnemyPool::remove(int index)
+{
+    // a sleeper leaves its bucket right away, so no bucket outgrows its
+    // reserve with handles that no longer resolve
+    if (level[index] == AI_ASLEEP)
+    {
+        std::vector<EntityHandle>& bucket = sleepBuckets[handle[index].slot % SLEEP_BUCKET_COUNT];
+        *std::find(bucket.begin(), bucket.end(), handle[index]) = bucket.back();
+        bucket.pop_back();
+    }
+    handles.destroy(handle[index]);
+
+    // fill the hole from the end of its group (through the last awake
+    // enemy if it was awake), then hand the hole on to the end of every
+    // later group the same way until it reaches the last index
+    const int removedType = type[index];
+    int hole = index;
+    if (index < asleepStart[removedType])
+    {
+        int lastAwake = --asleepStart[removedType];
+        if (lastAwake != hole)
+            moveEnemy(lastAwake, hole);
+        hole = lastAwake;
+    }
+    int last = groupStart[removedType + 1] - 1;
+    if (last != hole)
+        moveEnemy(last, hole);
+    hole = last;
+
+    for (int group = removedType + 1; group < ENEMY_TYPE_COUNT; group++)
+    {
+        int lastAwake = asleepStart[group] - 1;
+        last = groupStart[group + 1] - 1;
+        if (lastAwake != hole)
+            moveEnemy(lastAwake, hole);
+        if (last != lastAwake)
+            moveEnemy(last, lastAwake);
+        hole = last;
+        groupStart[group]--;
+        asleepStart[group]--;
+    }
+    groupStart[ENEMY_TYPE_COUNT]--;
+
+    posX.pop_back();
+    posY.pop_back();
+    lastX.pop_back();
+    lastY.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    health.pop_back();
+    speed.pop_back();
+    type.pop_back();
+    rightLeft.pop_back();
+    runningTime.pop_back();
+    frame.pop_back();
+    running.pop_back();
+    wasMoving.pop_back();
+    gridId.pop_back();
+    level.pop_back();
+    lastTick.pop_back();
+    handle.pop_back();
+}
+
+void EnemyPool::clear()
+{
+    posX.clear();
+    posY.clear();
+    lastX.clear();
+    lastY.clear();
+    prevX.clear();
+    prevY.clear();
+    health.clear();
+    speed.clear();
+    type.clear();
+    rightLeft.clear();
+    runningTime.clear();
+    frame.clear();
+    running.clear();
+    wasMoving.clear();
+    gridId.clear();
+    level.clear();
+    lastTick.clear();
+    handle.clear();
+    handles.clear();
+    groupStart.fill(0);
+    asleepStart.fill(0);
+    fellAsleep.fill(0);
+    for (auto& bucket : sleepBuckets)
+        bucket.clear();
+}
+
+void EnemyPool::saveState(SnapshotWriter& out) const
+{
+    out.writeVector(posX);
+    out.writeVector(posY);
+    out.writeVector(lastX);
+    out.writeVector(lastY);
+    out.writeVector(prevX);
+    out.writeVector(prevY);
+    out.writeVector(health);
+    out.writeVector(speed);
+    out.writeVector(type);
+    out.writeVector(rightLeft);
+    out.writeVector(runningTime);
+    out.writeVector(frame);
+    out.writeVector(running);
+    out.writeVector(wasMoving);
+    out.writeVector(gridId);
+    out.writeVector(level);
+    out.writeVector(lastTick);
+    out.writeVector(handle);
+    handles.saveState(out);
+    out.write(groupStart);
+    out.write(asleepStart);
+    for (const auto& bucket : sleepBuckets)
+        out.writeVector(bucket);
+    out.write(tickCount);
+}
+
+void EnemyPool::loadState(SnapshotReader& in)
+{
+    in.readVector(posX);
+    in.readVector(posY);
+    in.readVector(lastX);
+    in.readVector(lastY);
+    in.readVector(prevX);
+    in.readVector(prevY);
+    in.readVector(health);
+    in.readVector(speed);
+    in.readVector(type);
+    in.readVector(rightLeft);
+    in.readVector(runningTime);
+    in.readVector(frame);
+    in.readVector(running);
+    in.readVector(wasMoving);
+    in.readVector(gridId);
+    in.readVector(level);
+    in.readVector(lastTick);
+    in.readVector(handle);
+    handles.loadState(in);
+    in.read(groupStart);
+    in.read(asleepStart);
+    // only meaningful right after a tick, never in a snapshot
+    fellAsleep.fill(0);
+    for (auto& bucket : sleepBuckets)
+        in.readVector(bucket);
+    in.read(tickCount);
+}
+
+int EnemyPool::getAwakeCount() const
+{
+    int count{};
+    for (int group = 0; group < ENEMY_TYPE_COUNT; group++)
+        count += asleepStart[group] - groupStart[group];
+    return count;
+}
+
+// swap a sleeper to the front of its group's sleepers and count it awake
+void EnemyPool::wake(int index)
+{
+    int firstAsleep = asleepStart[type[index]]++;
+    if (index != firstAsleep)
+        swapEnemies(index, firstAsleep);
+    level[firstAsleep] = AI_MID;
+    // it slept through the ticks since, do not move it for them
+    lastTick[firstAsleep] = tickCount;
+}
+
+// swap an awake enemy behind its group's last awake enemy, which moves into
+// the sleepers, and file it in its bucket
+void EnemyPool::putToSleep(int index)
+{
+    int lastAwake = --asleepStart[type[index]];
+    fellAsleep[type[index]]++;
+    if (index != lastAwake)
+        swapEnemies(index, lastAwake);
+    level[lastAwake] = AI_ASLEEP;
+    // it stays put, no interpolation from where it was a step ago
+    prevX[lastAwake] = posX[lastAwake];
+    prevY[lastAwake] = posY[lastAwake];
+    sleepBuckets[handle[lastAwake].slot % SLEEP_BUCKET_COUNT].push_back(handle[lastAwake]);
+}
+
+void EnemyPool::wakeNearbySleepers(const TickTarget& target)
+{
+    std::vector<EntityHandle>& bucket = sleepBuckets[tickCount % SLEEP_BUCKET_COUNT];
+    for (std::size_t k = 0; k < bucket.size();)
+    {
+        int index = find(bucket[k]);
+        float dx = target.screenPos.x - (posX[index] - target.worldPos.x);
+        float dy = target.screenPos.y - (posY[index] - target.worldPos.y);
+        if (dx * dx + dy * dy < AI_WAKE_DISTANCE_SQ)
+        {
+            wake(index);
+            bucket[k] = bucket.back();
+            bucket.pop_back();
+        }
+        else
+        {
+            k++;
+        }
+    }
+}
+
+void EnemyPool::undoMovement(int index)
+{
+    posX[index] = lastX[index];
+    posY[index] = lastY[index];
+}
+
+void EnemyPool::savePositions()
+{
+    for (int group = 0; group < ENEMY_TYPE_COUNT; group++)
+    {
+        std::copy(posX.begin() + groupStart[group], posX.begin() + asleepStart[group], prevX.begin() + groupStart[group]);
+        std::copy(posY.begin() + groupStart[group], posY.begin() + asleepStart[group], prevY.begin() + groupStart[group]);
+    }
+}
+
+Vector2 EnemyPool::getRenderPos(int index, float alpha) const
+{
+    return Vector2{
+        prevX[index] + (posX[index] - prevX[index]) * alpha,
+        prevY[index] + (posY[index] - prevY[index]) * alpha
+    };
+}
+
+Rectangle EnemyPool::getWorldCollisionRec(int index) const
+{
+    return Rectangle{
+        posX[index],
+        posY[index],
+        CHARACTER_FRAME_WIDTH * ENEMY_SCALE,
+        CHARACTER_FRAME_HEIGHT * ENEMY_SCALE
+    };
+}
+
+template <std::size_t... Types>
+std::array<EnemyPool::TickRangeFn, sizeof...(Types)> EnemyPool::makeTickTable(std::index_sequence<Types...>)
+{
+    return {{&EnemyPool::tickRange<static_cast<int>(Types)>...}};
+}
+
+float EnemyPool::tick(float deltaTime, Vector2 targetScreenPos, Vector2 targetWorldPos,
+                      Rectangle targetWorldRec, const FlowField* flowField, JobSystem* jobs)
+{
+    PROFILE_ZONE("EnemyPool::tick");
+    static const auto tickRangeOf = makeTickTable(std::make_index_sequence<ENEMY_TYPE_COUNT>{});
+
+    const TickTarget target{deltaTime, targetScreenPos, targetWorldPos, targetWorldRec, flowField};
+
+    wakeNearbySleepers(target);
+    tickCount++;
+    fellAsleep.fill(0);
+
+    // split the awake part of every group into chunks, a chunk never mixes types
+    chunks.clear();
+    for (int group = 0; group < ENEMY_TYPE_COUNT; group++)
+    {
+        for (int begin = groupStart[group]; begin < asleepStart[group]; begin += ENEMY_CHUNK_SIZE)
+        {
+            int end = begin + ENEMY_CHUNK_SIZE < asleepStart[group] ? begin + ENEMY_CHUNK_SIZE : asleepStart[group];
+            chunks.push_back(Chunk{group, begin, end});
+        }
+    }
+    const int chunkCount = static_cast<int>(chunks.size());
+
+    auto runChunk = [&](int index) {
+        Chunk& chunk = chunks[index];
+        (this->*tickRangeOf[chunk.type])(chunk, target);
+    };
+    if (jobs && chunkCount > ENEMY_INLINE_CHUNKS)
+        jobs->run(chunkCount, runChunk);
+    else
+        for (int index = 0; index < chunkCount; index++)
+            runChunk(index);
+
+    float damage{};
+    for (const Chunk& chunk : chunks)
+        damage += chunk.damage;
+
+    // putting an enemy to sleep swaps it with its group's last awake enemy:
+    // walking back from the end only ever swaps in enemies already looked at
+    for (int index = chunkCount - 1; index >= 0; index--)
+    {
+        const Chunk& chunk = chunks[index];
+        if (chunk.fallingAsleep == 0)
+            continue;
+        for (int i = chunk.end - 1; i >= chunk.begin; i--)
+            if (level[i] == AI_ASLEEP)
+                putToSleep(i);
+    }
+    return damage;
+}
+
+// Updates the awake enemies of a chunk, all of archetype Type, so chunks can
+// run on any thread. The archetype is a compile-time constant here: its
+// radii and damage fold into the loop and nothing in it depends on the
+// enemy's type. Mid-range enemies skip the steps that are not their turn
+// (steering included) and then cover the whole time since their last
+// update in one move.
+template <int Type>
+void EnemyPool::tickRange(Chunk& chunk, const TickTarget& target)
+{
+    PROFILE_ZONE("EnemyPool::tickRange");
+    constexpr EnemyArchetype archetype = ENEMY_ARCHETYPES[Type];
+
+    // the enemies whose turn it is, gathered so the steering kernel only
+    // runs for them (mid-range enemies wait for their slot)
+    alignas(32) float dueX[ENEMY_CHUNK_SIZE];
+    alignas(32) float dueY[ENEMY_CHUNK_SIZE];
+    alignas(32) float dueVelX[ENEMY_CHUNK_SIZE];
+    alignas(32) float dueVelY[ENEMY_CHUNK_SIZE];
+    int dueIndex[ENEMY_CHUNK_SIZE];
+    int dueCount{};
+    for (int i = chunk.begin; i < chunk.end; i++)
+    {
+        if (level[i] == AI_MID && (tickCount + handle[i].slot) % AI_MID_INTERVAL != 0)
+            continue;
+        dueX[dueCount] = posX[i];
+        dueY[dueCount] = posY[i];
+        dueIndex[dueCount++] = i;
+    }
+
+    SteeringBatch batch;
+    batch.posX = dueX;
+    batch.posY = dueY;
+    batch.radius = archetype.radius;
+    batch.stopRadius = archetype.stopRadius();
+    batch.circleRadius = archetype.circleRadius();
+    batch.velX = dueVelX;
+    batch.velY = dueVelY;
+    batch.count = dueCount;
+    steerTowards(batch, target.screenPos, target.worldPos);
+
+    float damage{};
+    int fallingAsleep{};
+    for (int k = 0; k < dueCount; k++)
+    {
+        const int i = dueIndex[k];
+        const float deltaTime = static_cast<float>(tickCount - lastTick[i]) * target.deltaTime;
+        const float stepScale = deltaTime * SPEED_REFERENCE_RATE;
+        lastTick[i] = tickCount;
+
+        float vx = dueVelX[k];
+        float vy = dueVelY[k];
+
+        lastX[i] = posX[i];
+        lastY[i] = posY[i];
+
+        float length = std::sqrt(vx * vx + vy * vy);
+        bool isMoving = (length != 0.f);
+
+        // straight at the target unless a prop is in the way: then follow
+        // the shared flow field around it
+        if (isMoving && target.flowField)
+        {
+            Vector2 center{posX[i] + ENEMY_HALF_SIZE, posY[i] + ENEMY_HALF_SIZE};
+            Vector2 ahead{center.x + vx / length * FLOW_LOOKAHEAD, center.y + vy / length * FLOW_LOOKAHEAD};
+            if (target.flowField->isBlocked(center) || target.flowField->isBlocked(ahead))
+            {
+                Vector2 route = target.flowField->getDirection(center);
+                if (route.x != 0.f || route.y != 0.f)
+                {
+                    vx = route.x;
+                    vy = route.y;
+                    length = 1.f;
+                }
+            }
+        }
+
+        // Always update animation timing
+        runningTime[i] += deltaTime;
+
+        float frameTime = ENEMY_UPDATE_TIME;
+        if (isMoving)
+        {
+            // move along the normalized direction
+            float inverseLength = 1.f / length;
+            float distance = speed[i] * stepScale;
+            posX[i] = posX[i] + vx * inverseLength * distance;
+            posY[i] = posY[i] + vy * inverseLength * distance;
+            rightLeft[i] = vx < 0.f ? -1.f : 1.f;
+        }
+        else
+        {
+            // Keep idle animation running but slower
+            frameTime = ENEMY_UPDATE_TIME * 3.0f;
+        }
+
+        // switch sheet and restart the animation when starting or stopping
+        if (isMoving != (wasMoving[i] != 0))
+        {
+            running[i] = isMoving ? 1 : 0;
+            frame[i] = 0;
+            runningTime[i] = 0.f;
+        }
+
+        if (runningTime[i] >= frameTime)
+        {
+            frame[i]++;
+            runningTime[i] = 0.f;
+            if (frame[i] >= CHARACTER_MAX_FRAMES)
+                frame[i] = 0;
+        }
+
+        wasMoving[i] = isMoving ? 1 : 0;
+
+        // contact damage, then push the enemy back out of the target
+        if (recsOverlap(getWorldCollisionRec(i), target.worldRec))
+        {
+            damage += archetype.damagePerSec * deltaTime;
+            undoMovement(i);
+        }
+
+        // level of detail for the next step
+        float dx = target.screenPos.x - (posX[i] - target.worldPos.x);
+        float dy = target.screenPos.y - (posY[i] - target.worldPos.y);
+        float distanceSq = dx * dx + dy * dy;
+        if (distanceSq > AI_SLEEP_DISTANCE_SQ)
+        {
+            // tick() moves it to the sleepers once every chunk is done
+            level[i] = AI_ASLEEP;
+            fallingAsleep++;
+        }
+        else
+        {
+            level[i] = distanceSq < AI_NEAR_DISTANCE_SQ ? AI_NEAR : AI_MID;
+        }
+    }
+    chunk.damage = damage;
+    chunk.fallingAsleep = fallingAsleep;
+}
@@ -0,0 +1,163 @@
+#ifndef ENEMY_POOL_H
+#define ENEMY_POOL_H
+
+#include "raylib.h"
+#include "EnemyArchetype.h"
+#include "SlotMap.h"
+#include "Snapshot.h"
+#include <array>
+#include <utility>
+#include <vector>
+
+class FlowField;
+class JobSystem;
+
+// Every enemy in the level, stored as parallel arrays (struct of arrays) so
+// the per-step update is one tight loop over contiguous memory. The arrays
+// are kept grouped by type (archetype): each group is updated by its own
+// template instance of the loop, with the archetype's stats as constants
+// (see EnemyArchetype.h). An enemy is just an index; add() and remove()
+// shift one enemy per later group to keep the groups packed, so indices are
+// only stable until the next add() or remove(). Anything that has to refer
+// to an enemy across steps holds an EntityHandle instead, see find().
+//
+// AI level of detail, by distance from the knight: enemies on or near the
+// screen update every step, mid-range ones every few steps (moving the
+// whole elapsed time along their heading at once), and far ones sleep.
+// Sleepers sit at the end of their type's group where tick() never looks;
+// they are checked for waking one bucket per step, so the per-step cost
+// follows the enemies around the knight, not the size of the pool.
+class EnemyPool
+{
+public:
+    enum EnemyType { GOBLIN, SLIME, INTELLECT_DEVOURER, ELITE_GOBLIN, SLIME_KING, ENEMY_TYPE_COUNT };
+
+    // room for this many enemies before add() allocates again
+    void reserve(int capacity);
+    // returns the index of the new enemy
+    int add(Vector2 pos, float enemySpeed, EnemyType enemyType);
+    void remove(int index);
+    void clear();
+    // every enemy and the pool's bookkeeping, for World snapshots
+    void saveState(SnapshotWriter& out) const;
+    void loadState(SnapshotReader& in);
+    int size() const { return static_cast<int>(posX.size()); }
+    bool empty() const { return posX.empty(); }
+    // stable reference to the enemy now at index
+    EntityHandle getHandle(int index) const { return handle[index]; }
+    // current index of a handle's enemy, -1 once it has been removed
+    int find(EntityHandle enemy) const { return handles.find(enemy); }
+    // awake enemies of a type are [getGroupBegin(t), getAsleepBegin(t)),
+    // its sleeping ones the rest of the group, up to getGroupBegin(t + 1)
+    int getGroupBegin(int enemyType) const { return groupStart[enemyType]; }
+    int getAsleepBegin(int enemyType) const { return asleepStart[enemyType]; }
+    // enemies the last tick() may have moved: the awake ones and the ones it
+    // put to sleep, [getGroupBegin(t), getMovedEnd(t)) until the next add()
+    // or remove()
+    int getMovedEnd(int enemyType) const { return asleepStart[enemyType] + fellAsleep[enemyType]; }
+    int getAwakeCount() const;
+
+    // wake the sleepers of this step's bucket that the target came close
+    // to, then steer every awake enemy whose turn it is toward the target,
+    // advance its animation and push it back if it touches targetWorldRec,
+    // and put the ones that fell too far behind to sleep. Returns the
+    // contact damage dealt to the target this step.
+    // targetScreenPos/targetWorldPos/targetWorldRec are the knight's, see
+    // Character. Enemies about to run into an obstacle of flowField follow
+    // it instead (it has to lead to the same target). With a job system the
+    // pool is updated in fixed-size chunks spread over its threads; the
+    // result does not depend on the thread count.
+    float tick(float deltaTime, Vector2 targetScreenPos, Vector2 targetWorldPos,
+               Rectangle targetWorldRec, const FlowField* flowField = nullptr,
+               JobSystem* jobs = nullptr);
+    void undoMovement(int index);
+    // remember where every enemy is before a step, for getRenderPos()
+    // (sleepers do not move, so only the awake ones are copied)
+    void savePositions();
+    // position between the last two steps, alpha 0 (previous) to 1 (current)
+    Vector2 getRenderPos(int index, float alpha) const;
+
+    Vector2 getWorldPos(int index) const { return Vector2{posX[index], posY[index]}; }
+    Rectangle getWorldCollisionRec(int index) const;
+    EnemyType getType(int index) const { return static_cast<EnemyType>(type[index]); }
+    int getFrame(int index) const { return frame[index]; }
+    bool getRunning(int index) const { return running[index] != 0; }
+    float getRightLeft(int index) const { return rightLeft[index]; }
+    // entry in the World's broadphase grid
+    int getGridId(int index) const { return gridId[index]; }
+    void setGridId(int index, int id) { gridId[index] = id; }
+private:
+    enum AiLevel { AI_NEAR, AI_MID, AI_ASLEEP };
+    // sleepers are checked for waking every this many steps
+    static constexpr int SLEEP_BUCKET_COUNT{16};
+
+    struct TickTarget
+    {
+        float deltaTime{};
+        Vector2 screenPos{};
+        Vector2 worldPos{};
+        Rectangle worldRec{};
+        const FlowField* flowField{};
+    };
+    // a run of awake enemies of one type, updated as one job, and what the
+    // job found: the contact damage it summed (merged in order) and how
+    // many of its enemies now want to sleep
+    struct Chunk
+    {
+        int type{};
+        int begin{};
+        int end{};
+        float damage{};
+        int fallingAsleep{};
+    };
+    using TickRangeFn = void (EnemyPool::*)(Chunk& chunk, const TickTarget& target);
+
+    // position and the position before the last tick (for undoMovement)
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> lastX;
+    std::vector<float> lastY;
+    // position at the start of the step, for render interpolation
+    std::vector<float> prevX;
+    std::vector<float> prevY;
+    std::vector<float> health;
+    std::vector<float> speed;
+    std::vector<unsigned char> type;
+    // animation: 1 facing right, -1 facing left
+    std::vector<float> rightLeft;
+    std::vector<float> runningTime;
+    std::vector<int> frame;
+    std::vector<unsigned char> running;
+    std::vector<unsigned char> wasMoving;
+    std::vector<int> gridId;
+    // AiLevel, and the tick the enemy was last updated in
+    std::vector<unsigned char> level;
+    std::vector<unsigned int> lastTick;
+    std::vector<EntityHandle> handle;
+    SlotMap handles;
+    // type t occupies indices [groupStart[t], groupStart[t + 1]), its
+    // sleepers the end of that from asleepStart[t]
+    std::array<int, ENEMY_TYPE_COUNT + 1> groupStart{};
+    std::array<int, ENEMY_TYPE_COUNT> asleepStart{};
+    // enemies put to sleep by the last tick, right behind asleepStart[t]
+    std::array<int, ENEMY_TYPE_COUNT> fellAsleep{};
+    // sleepers by handle slot; remove() takes a sleeper out of its bucket
+    std::array<std::vector<EntityHandle>, SLEEP_BUCKET_COUNT> sleepBuckets;
+    // ticks run so far
+    unsigned int tickCount{};
+    // this tick's jobs
+    std::vector<Chunk> chunks;
+
+    void moveEnemy(int from, int to);
+    void swapEnemies(int a, int b);
+    void wake(int index);
+    void putToSleep(int index);
+    void wakeNearbySleepers(const TickTarget& target);
+    template <int Type>
+    void tickRange(Chunk& chunk, const TickTarget& target);
+    // tickRange<0>, tickRange<1>, ... one per archetype
+    template <std::size_t... Types>
+    static std::array<TickRangeFn, sizeof...(Types)> makeTickTable(std::index_sequence<Types...>);
+};
+
+#endif
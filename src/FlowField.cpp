@@ -0,0 +1,191 @@
+#include "FlowField.h"
+#include <climits>
+#include <utility>
+
+const int UNREACHED{INT_MAX};
+const unsigned char NO_DIRECTION{255};
+
+// neighbour offsets, the four straight ones first
+const int NEIGHBOUR_COLUMN[8]{1, 0, -1, 0, 1, -1, -1, 1};
+const int NEIGHBOUR_ROW[8]{0, 1, 0, -1, 1, 1, -1, -1};
+const float DIAGONAL{0.70710678f};
+const Vector2 NEIGHBOUR_DIRECTION[8]{
+    {1.f, 0.f}, {0.f, 1.f}, {-1.f, 0.f}, {0.f, -1.f},
+    {DIAGONAL, DIAGONAL}, {-DIAGONAL, DIAGONAL}, {-DIAGONAL, -DIAGONAL}, {DIAGONAL, -DIAGONAL}};
+
+FlowField::FlowField(Rectangle fieldBounds, float fieldCellSize):
+    bounds(fieldBounds),
+    cellSize(fieldCellSize),
+    columns(static_cast<int>(fieldBounds.width / fieldCellSize) + 1),
+    rows(static_cast<int>(fieldBounds.height / fieldCellSize) + 1),
+    blocked(columns * rows, 0)
+{
+    current.distance.assign(columns * rows, UNREACHED);
+    current.direction.assign(columns * rows, NO_DIRECTION);
+    frontier.reserve(columns * rows);
+}
+
+void FlowField::addObstacle(Rectangle rect)
+{
+    for (int row = 0; row < rows; row++)
+    {
+        float cellY = bounds.y + row * cellSize;
+        if (cellY + cellSize <= rect.y || cellY >= rect.y + rect.height)
+            continue;
+        for (int column = 0; column < columns; column++)
+        {
+            float cellX = bounds.x + column * cellSize;
+            if (cellX + cellSize <= rect.x || cellX >= rect.x + rect.width)
+                continue;
+            blocked[row * columns + column] = 1;
+        }
+    }
+}
+
+int FlowField::cellOf(Vector2 pos) const
+{
+    int column = static_cast<int>((pos.x - bounds.x) / cellSize);
+    int row = static_cast<int>((pos.y - bounds.y) / cellSize);
+    if (pos.x < bounds.x) column = 0;
+    if (pos.y < bounds.y) row = 0;
+    if (column >= columns) column = columns - 1;
+    if (row >= rows) row = rows - 1;
+    return row * columns + column;
+}
+
+bool FlowField::isFree(int column, int row) const
+{
+    return column >= 0 && column < columns && row >= 0 && row < rows &&
+           blocked[row * columns + column] == 0;
+}
+
+void FlowField::update(Vector2 target, int cellBudget)
+{
+    int targetCell = cellOf(target);
+    if (targetCell != nextTarget)
+    {
+        // the target may stand in a blocked cell, the search still starts there
+        nextTarget = targetCell;
+        next.distance.assign(columns * rows, UNREACHED);
+        next.direction.assign(columns * rows, NO_DIRECTION);
+        frontier.clear();
+        head = 0;
+        next.distance[targetCell] = 0;
+        frontier.push_back(targetCell);
+    }
+    if (head < frontier.size())
+        integrate(cellBudget);
+}
+
+// Pops up to cellBudget cells off the breadth-first queue. Every cell with
+// fewer steps than the popped one is already reached by then, so its
+// direction (toward the neighbour with the fewest steps; diagonals only
+// when both straight neighbours beside them are free) is final right away.
+void FlowField::integrate(int cellBudget)
+{
+    for (int processed = 0; processed < cellBudget && head < frontier.size(); processed++)
+    {
+        int cell = frontier[head++];
+        int column = cell % columns;
+        int row = cell / columns;
+        int distance = next.distance[cell];
+
+        int bestDistance = distance;
+        for (int k = 0; k < 8; k++)
+        {
+            int neighbourColumn = column + NEIGHBOUR_COLUMN[k];
+            int neighbourRow = row + NEIGHBOUR_ROW[k];
+            if (!isFree(neighbourColumn, neighbourRow))
+                continue;
+            if (k >= 4 && (!isFree(neighbourColumn, row) || !isFree(column, neighbourRow)))
+                continue;
+            int neighbourDistance = next.distance[neighbourRow * columns + neighbourColumn];
+            if (neighbourDistance < bestDistance)
+            {
+                bestDistance = neighbourDistance;
+                next.direction[cell] = static_cast<unsigned char>(k);
+            }
+        }
+
+        for (int k = 0; k < 4; k++)
+        {
+            int neighbourColumn = column + NEIGHBOUR_COLUMN[k];
+            int neighbourRow = row + NEIGHBOUR_ROW[k];
+            if (!isFree(neighbourColumn, neighbourRow))
+                continue;
+            int neighbour = neighbourRow * columns + neighbourColumn;
+            if (next.distance[neighbour] == UNREACHED)
+            {
+                next.distance[neighbour] = distance + 1;
+                frontier.push_back(neighbour);
+            }
+        }
+    }
+
+    // finished: the new field takes over (the queue stays drained until
+    // the target changes cells again)
+    if (head == frontier.size())
+    {
+        std::swap(current, next);
+        ready = true;
+    }
+}
+
+Vector2 FlowField::getDirection(Vector2 pos) const
+{
+    if (!ready)
+        return Vector2{0.f, 0.f};
+
+    int cell = cellOf(pos);
+    if (blocked[cell] == 0)
+    {
+        unsigned char direction = current.direction[cell];
+        return direction == NO_DIRECTION ? Vector2{0.f, 0.f} : NEIGHBOUR_DIRECTION[direction];
+    }
+
+    // inside an obstacle's margin: head for the free neighbour closest to the target
+    int column = cell % columns;
+    int row = cell / columns;
+    int bestDistance = UNREACHED;
+    Vector2 best{0.f, 0.f};
+    for (int k = 0; k < 8; k++)
+    {
+        int neighbourColumn = column + NEIGHBOUR_COLUMN[k];
+        int neighbourRow = row + NEIGHBOUR_ROW[k];
+        if (!isFree(neighbourColumn, neighbourRow))
+            continue;
+        int neighbourDistance = current.distance[neighbourRow * columns + neighbourColumn];
+        if (neighbourDistance < bestDistance)
+        {
+            bestDistance = neighbourDistance;
+            best = NEIGHBOUR_DIRECTION[k];
+        }
+    }
+    return best;
+}
+
+void FlowField::saveState(SnapshotWriter& out) const
+{
+    out.writeVector(blocked);
+    out.writeVector(current.distance);
+    out.writeVector(current.direction);
+    out.writeVector(next.distance);
+    out.writeVector(next.direction);
+    out.write(ready);
+    out.write(nextTarget);
+    out.writeVector(frontier);
+    out.write(head);
+}
+
+void FlowField::loadState(SnapshotReader& in)
+{
+    in.readVector(blocked);
+    in.readVector(current.distance);
+    in.readVector(current.direction);
+    in.readVector(next.distance);
+    in.readVector(next.direction);
+    in.read(ready);
+    in.read(nextTarget);
+    in.readVector(frontier);
+    in.read(head);
+}
@@ -0,0 +1,62 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "raylib.h"
+#include "Snapshot.h"
+#include <vector>
+
+// Shared route to one target around obstacles: a grid over the world where
+// every cell points at its neighbour with the fewest steps left to the
+// target's cell, so any number of enemies look their way up in O(1).
+// The field is rebuilt breadth-first only when the target enters another
+// cell, a limited number of cells per update(); until the new field is
+// finished the previous one keeps answering. Positions outside the bounds
+// are clamped into the border cells.
+class FlowField
+{
+public:
+    FlowField(Rectangle fieldBounds, float fieldCellSize);
+    // cells overlapping rect can not be entered (add before the first update)
+    void addObstacle(Rectangle rect);
+    // start over toward target's cell if it moved, then integrate at most
+    // cellBudget more cells of the field being built
+    void update(Vector2 target, int cellBudget);
+
+    bool isBlocked(Vector2 pos) const { return blocked[cellOf(pos)] != 0; }
+    // unit direction to follow from pos, {0, 0} in the target's cell, where
+    // no route exists and before the first field is finished. From inside
+    // an obstacle it leads out toward the target
+    Vector2 getDirection(Vector2 pos) const;
+
+    // into a field with the same bounds and cell size
+    void saveState(SnapshotWriter& out) const;
+    void loadState(SnapshotReader& in);
+private:
+    // one field: steps to the target and the direction (index into the
+    // neighbour table) per cell
+    struct Layer
+    {
+        std::vector<int> distance;
+        std::vector<unsigned char> direction;
+    };
+
+    Rectangle bounds{};
+    float cellSize{};
+    int columns{};
+    int rows{};
+    std::vector<unsigned char> blocked;
+    // the field answering queries and the one being built
+    Layer current;
+    Layer next;
+    bool ready{false};
+    int nextTarget{-1};
+    // breadth-first queue of the field being built, popped from head
+    std::vector<int> frontier;
+    std::size_t head{};
+
+    int cellOf(Vector2 pos) const;
+    bool isFree(int column, int row) const;
+    void integrate(int cellBudget);
+};
+
+#endif
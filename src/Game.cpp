@@ -0,0 +1,399 @@
+#include "Game.h"
+#include "Timing.h"
+#include "AtlasData.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <string>
+#include <random>
+#define SKYBLUEE    CLITERAL(Color){ 125, 210, 255, 255 }   // Sky Blue
+
+// HUD layer: where it sits on screen and how big it is
+const Vector2 HUD_POS{55.f, 45.f};
+const int HUD_WIDTH{360};
+const int HUD_HEIGHT{75};
+
+#if defined(ENABLE_PROFILER)
+    // F4 captures this many frames (about two seconds) and writes them here
+    #define PROFILER_TRACE_PATH "profile_trace.json"
+    const int PROFILER_CAPTURE_FRAMES{120};
+#endif
+
+#if defined(PLATFORM_WEB) && defined(ENABLE_PROFILER)
+    #include <emscripten/emscripten.h>
+
+// hand the trace to the browser as a file download
+extern "C" EMSCRIPTEN_KEEPALIVE void downloadProfilerTrace()
+{
+    std::string json = Profiler::get().buildTrace();
+    EM_ASM({
+        var blob = new Blob([UTF8ToString($0, $1)], {type: 'application/json'});
+        var link = document.createElement('a');
+        link.href = URL.createObjectURL(blob);
+        link.download = 'profile_trace.json';
+        link.click();
+        URL.revokeObjectURL(link.href);
+    }, json.c_str(), json.size());
+}
+#endif
+
+// Keyboard state for this frame as simulation input
+static WorldInput readInput()
+{
+    WorldInput input{};
+    if (IsKeyDown(KEY_A)) input.held |= INPUT_LEFT;
+    if (IsKeyDown(KEY_D)) input.held |= INPUT_RIGHT;
+    if (IsKeyDown(KEY_W)) input.held |= INPUT_UP;
+    if (IsKeyDown(KEY_S)) input.held |= INPUT_DOWN;
+    if (IsKeyDown(KEY_SPACE)) input.held |= INPUT_ATTACK;
+    if (IsKeyPressed(KEY_SPACE)) input.pressed |= INPUT_ATTACK;
+    return input;
+}
+
+static unsigned int randomSeed()
+{
+    std::random_device rd;
+    return rd();
+}
+
+Game::Game(int winWidth, int winHeight, const GameOptions& options):
+    windowWidth(winWidth),
+    windowHeight(winHeight),
+    gameplayBundle("gameplay.js", ATLAS_IMAGE_PATH),
+    openScreen(assets),
+    hud(HUD_WIDTH, HUD_HEIGHT),
+    seed(options.replayPath && replay.open(options.replayPath) ? replay.getSeed() : randomSeed()),
+    // the simulation itself never touches the window, audio or keyboard
+    world(winWidth, winHeight, seed)
+{
+    if (options.replayPath)
+    {
+        if (!replay.isOpen())
+            TraceLog(LOG_WARNING, "REPLAY: %s is not a recording, playing live", options.replayPath);
+        else if (replay.getViewWidth() != winWidth || replay.getViewHeight() != winHeight)
+            TraceLog(LOG_WARNING, "REPLAY: %s was recorded at %dx%d, it will not play back exactly",
+                     options.replayPath, replay.getViewWidth(), replay.getViewHeight());
+    }
+    if (options.recordPath)
+    {
+        if (recorder.open(options.recordPath, seed, winWidth, winHeight))
+            TraceLog(LOG_INFO, "REPLAY: Recording to %s (seed %u)", options.recordPath, seed);
+        else
+            TraceLog(LOG_WARNING, "REPLAY: Could not create %s", options.recordPath);
+    }
+
+    // the title screen only needs the boot bundle (see the Makefile)
+    music.load(MUSIC_TITLE, "nature_tileset/A town without hope (no loop)");
+    openScreenBackground = assets.getTexture("nature_tileset/Space_Background_fit.png");
+
+    // one worker per spare core on desktop, none on the web
+    world.setJobSystem(&jobs);
+    world.saveState(initialState);
+
+    // the browser paces the web build (requestAnimationFrame)
+#if !defined(PLATFORM_WEB)
+    SetTargetFPS(60);
+#endif
+
+    music.play(MUSIC_TITLE, 0.f);
+
+    gameplayBundle.request();
+}
+
+Game::~Game()
+{
+    music.stop();
+}
+
+void Game::loadGameplayAssets()
+{
+    // some of the sound assets 
+    music.load(MUSIC_GAMEPLAY, "nature_tileset/Desecrated Cave ver.1");
+    // volume, pitch (the tempo of the stride and the attack), voices,
+    // priority, retrigger, positional
+    sounds.load(SOUND_DEFEAT, assets, "nature_tileset/gameover_loud.mp3",
+                SoundSettings{0.2f, 2.7f, 1, 3, false, false});
+    sounds.load(SOUND_ATTACK, assets, "nature_tileset/07_human_atk_sword_2.wav",
+                SoundSettings{0.65f, 1.8f, 1, 2, false, false});
+    // a few voices of the kill sound so simultaneous kills overlap
+    sounds.load(SOUND_ENEMY_KILLED, assets, "nature_tileset/21_orc_damage_3.wav",
+                SoundSettings{1.f, 1.f, 4, 1, true, true});
+    sounds.load(SOUND_STRIDE, assets, "nature_tileset/16_human_walk_stone_3.wav",
+                SoundSettings{0.8f, 2.05f, 1, 0, false, false});
+
+    renderer = std::make_unique<Renderer>(assets);
+    // phones are fill-rate bound: the web build draws the world at the
+    // art's resolution, F2 switches either way
+#if defined(PLATFORM_WEB)
+    renderer->setLowResolution(true);
+#endif
+    gameplayLoaded = true;
+}
+
+void Game::setScene(Scene next)
+{
+    if (next == PLAYING)
+        music.play(MUSIC_GAMEPLAY, 1.5f);
+    scene = next;
+}
+
+void Game::frame()
+{
+    float frameTime = GetFrameTime();
+#if defined(ENABLE_PROFILER)
+    Profiler::get().beginFrame();
+#endif
+
+    // F2: world at the art's resolution (upscaled) or at full resolution
+    if (renderer && IsKeyPressed(KEY_F2))
+        renderer->setLowResolution(!renderer->getLowResolution());
+
+    BeginDrawing();
+    switch(scene)
+    {
+        case TITLE:
+            updateTitle(frameTime);
+            break;
+        case PLAYING:
+            updatePlaying(frameTime);
+            break;
+        case GAME_OVER:
+            ClearBackground(SKYBLUEE);
+            renderer->drawWorld(world);
+            updateGameOver();
+            offerRestart();
+            break;
+        case VICTORY:
+            ClearBackground(SKYBLUEE);
+            renderer->drawWorld(world);
+            // Victory condition - all enemies defeated!
+            DrawText("VICTORY!", 240.f, windowHeight / 2.3f, 48, GOLD);
+            DrawText("All enemies defeated!", 180.f, windowHeight / 2.3f + 60.f, 32, LIME);
+            offerRestart();
+            break;
+    }
+    {
+        PROFILE_ZONE("Music");
+        music.update(frameTime);
+    }
+    if (gameplayLoaded)
+    {
+        // the knight is the listener
+        Rectangle knightRec = world.getKnight().getWorldCollisionRec();
+        sounds.update(Vector2{knightRec.x + knightRec.width * 0.5f, knightRec.y + knightRec.height * 0.5f});
+    }
+#if defined(ENABLE_PROFILER)
+    updateProfiler();
+#endif
+    {
+        PROFILE_ZONE("EndDrawing");
+        EndDrawing();
+    }
+#if defined(ENABLE_PROFILER)
+    endProfilerFrame();
+#endif
+}
+
+void Game::updateTitle(float frameTime)
+{
+    Vector2 mapPos{0.0, 0.0};
+    ClearBackground(BLACK);
+
+    DrawTextureEx(*openScreenBackground, mapPos, 0.0, 1.f, WHITE);
+    openScreen.Tick(frameTime, mapPos);
+
+    if (!gameplayLoaded && gameplayBundle.isReady())
+        loadGameplayAssets();
+
+    if (IsKeyDown(KEY_ENTER))
+        startRequested = true;
+    if (startRequested && gameplayLoaded)
+        setScene(PLAYING);
+    else if (startRequested)
+        DrawText("Loading...", 260.f, 230.f, 28, LIGHTGRAY);
+}
+
+void Game::updatePlaying(float frameTime)
+{
+    if (frameTime > MAX_FRAME_TIME)
+        frameTime = MAX_FRAME_TIME;
+    accumulator += frameTime;
+
+    WorldInput frameInput{};
+    {
+        PROFILE_ZONE("Input");
+        frameInput = readInput();
+        pendingPressed |= frameInput.pressed;
+    }
+
+    // run as many fixed steps as the frame covered, 0 on fast displays
+    int steps{};
+    while (accumulator >= FIXED_TIME_STEP)
+    {
+        WorldInput stepInput{frameInput.held, pendingPressed};
+        pendingPressed = 0;
+        // a replay stands in for the keyboard until it runs out
+        if (replay.isOpen() && !replay.next(stepInput))
+        {
+            TraceLog(LOG_INFO, "REPLAY: Finished after %ld steps", replay.getStep());
+            stepInput = WorldInput{frameInput.held, 0};
+        }
+        recorder.record(stepInput);
+        world.step(FIXED_TIME_STEP, stepInput);
+        const WorldEvents& events = world.getEvents();
+        for (int i = 0; i < events.enemiesKilled && i < WorldEvents::MAX_KILL_POSITIONS; i++)
+            sounds.push(SOUND_ENEMY_KILLED, events.killPositions[i]);
+        accumulator -= FIXED_TIME_STEP;
+        steps++;
+    }
+    float alpha = accumulator / FIXED_TIME_STEP;
+    PROFILE_COUNTER("Steps", steps);
+    PROFILE_COUNTER("Enemies", world.getEnemies().size());
+    PROFILE_COUNTER("Awake enemies", world.getEnemies().getAwakeCount());
+
+    const Character& knight = world.getKnight();
+    if (knight.isStriding() && !world.isGameOver())
+        sounds.push(SOUND_STRIDE);
+    if (knight.isAttacking() && !world.isGameOver())
+        sounds.push(SOUND_ATTACK);
+
+    ClearBackground(SKYBLUEE);
+    renderer->drawWorld(world, alpha);
+
+    if (world.isGameOver())
+    {
+        sounds.push(SOUND_DEFEAT);
+        setScene(GAME_OVER);
+        updateGameOver();
+    }
+    else if (world.isVictory())
+        setScene(VICTORY);
+    else
+        drawHud();
+}
+
+void Game::updateGameOver()
+{
+    DrawText("Game Over!", 220.f, windowHeight / 2.3f, 48, RED);
+}
+
+void Game::offerRestart()
+{
+    DrawText("Press Enter To Play Again", 175.f, windowHeight / 2.3f + 110.f, 24, WHITE);
+    if (IsKeyPressed(KEY_ENTER))
+        restart();
+}
+
+// Textures, sounds and music stay loaded: only the World goes back to its
+// state after setup, which is a copy of a flat buffer
+void Game::restart()
+{
+    world.loadState(initialState);
+    // a new round rather than a rerun of the last one
+    world.reseed(randomSeed());
+    accumulator = 0.f;
+    pendingPressed = 0;
+
+    // recordings and replays cover one round
+    recorder.close();
+    replay.close();
+
+    sounds.stop(SOUND_DEFEAT);
+    setScene(PLAYING);
+}
+
+void Game::drawHud()
+{
+    PROFILE_ZONE("HUD");
+    // whole health points, so taking damage redraws a few times a second
+    // rather than every frame
+    int health = static_cast<int>(world.getKnight().getHealth());
+    int enemyCount = world.getEnemies().size();
+    if (health != hudHealth || enemyCount != hudEnemies)
+    {
+        hudHealth = health;
+        hudEnemies = enemyCount;
+        char text[32];
+
+        hud.begin();
+        // draw health color based on value
+        Color healthColor = health >= 75 ? LIME : (health >= 45 ? YELLOW : MAROON);
+        std::snprintf(text, sizeof(text), "Health: %d", health);
+        DrawText(text, 0, 0, 36, healthColor);
+
+        // Display enemy count
+        std::snprintf(text, sizeof(text), "Enemies: %d", enemyCount);
+        DrawText(text, 0, 45, 24, WHITE);
+        hud.end();
+    }
+    hud.draw(HUD_POS);
+}
+
+#if defined(ENABLE_PROFILER)
+void Game::updateProfiler()
+{
+    if (IsKeyPressed(KEY_F3))
+        showProfiler = !showProfiler;
+    // the capture starts with the next frame
+    if (IsKeyPressed(KEY_F4) && captureFrames == 0)
+    {
+        Profiler::get().clear();
+        captureFrames = PROFILER_CAPTURE_FRAMES + 1;
+    }
+    if (!showProfiler)
+        return;
+
+    const Profiler& profiler = Profiler::get();
+    const auto& zones = profiler.getZoneStats();
+    const auto& counters = profiler.getCounters();
+    const int lineHeight{14};
+    int lines = 1 + static_cast<int>(zones.size() + counters.size()) + (renderer ? 2 : 0);
+    int y{8};
+
+    DrawRectangle(windowWidth - 300, 4, 296, lines * lineHeight + 8, Fade(BLACK, 0.7f));
+    DrawText(TextFormat("frame %5.2f ms   (%d fps)", profiler.getFrameMs(), GetFPS()),
+             windowWidth - 292, y, 10, WHITE);
+    // averages over the last second of frames
+    for (const auto& zone : zones)
+    {
+        y += lineHeight;
+        DrawText(TextFormat("%-24s %6.3f ms  x%d", zone.name, zone.averageMs, zone.calls),
+                 windowWidth - 292, y, 10, LIME);
+    }
+    for (const auto& counter : counters)
+    {
+        y += lineHeight;
+        DrawText(TextFormat("%-24s %d", counter.name, counter.value), windowWidth - 292, y, 10, SKYBLUE);
+    }
+    if (renderer)
+    {
+        y += lineHeight;
+        DrawText(TextFormat("%-24s %d", "Draw commands", renderer->getDrawList().size()),
+                 windowWidth - 292, y, 10, SKYBLUE);
+        y += lineHeight;
+        DrawText(TextFormat("%-24s %d", "Texture switches", renderer->getDrawList().getTextureSwitches()),
+                 windowWidth - 292, y, 10, SKYBLUE);
+    }
+}
+
+void Game::endProfilerFrame()
+{
+    Profiler& profiler = Profiler::get();
+    profiler.endFrame();
+
+    if (captureFrames > 0 && --captureFrames == 0)
+    {
+#if defined(PLATFORM_WEB)
+        downloadProfilerTrace();
+#else
+        if (profiler.writeTrace(PROFILER_TRACE_PATH))
+            TraceLog(LOG_INFO, "PROFILER: Trace written to %s", PROFILER_TRACE_PATH);
+#endif
+    }
+
+    // record the next frame only if someone looks at it
+    if (showProfiler || captureFrames > 0)
+        profiler.start();
+    else
+        profiler.stop();
+}
+#endif
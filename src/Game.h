@@ -0,0 +1,98 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "raylib.h"
+#include "AssetCache.h"
+#include "AssetBundle.h"
+#include "MusicPlayer.h"
+#include "SoundMixer.h"
+#include "DynamicScreen.h"
+#include "UiLayer.h"
+#include "Renderer.h"
+#include "World.h"
+#include "JobSystem.h"
+#include "InputRecording.h"
+#include <memory>
+
+// The front end: owns every texture, sound and the World, and runs one
+// frame per call to frame(). Nothing blocks inside a frame, so the browser
+// can drive it from its own loop (emscripten_set_main_loop_arg) and the web
+// build needs no ASYNCIFY. Needs an open window and audio device for its
+// whole lifetime.
+
+// command line options (desktop)
+struct GameOptions
+{
+    // save the session's seed and input here
+    const char* recordPath{nullptr};
+    // play this recording instead of the keyboard, from the first step
+    const char* replayPath{nullptr};
+};
+
+class Game
+{
+public:
+    enum Scene { TITLE, PLAYING, GAME_OVER, VICTORY };
+
+    Game(int winWidth, int winHeight, const GameOptions& options = GameOptions{});
+    Game(const Game&) = delete;
+    Game& operator=(const Game&) = delete;
+    ~Game();
+    // read input, update and draw the current scene
+    void frame();
+    Scene getScene() const { return scene; }
+private:
+    int windowWidth{};
+    int windowHeight{};
+    Scene scene{TITLE};
+
+    AssetCache assets;
+    // everything past the title screen, downloaded while the title runs
+    AssetBundle gameplayBundle;
+    bool gameplayLoaded{false};
+    // Enter was pressed before the gameplay bundle arrived
+    bool startRequested{false};
+    MusicPlayer music;
+    SoundMixer sounds;
+
+    DynamicScreen openScreen;
+    TextureHandle openScreenBackground;
+    std::unique_ptr<Renderer> renderer;
+    // health and enemy count, redrawn only when the shown values change
+    UiLayer hud;
+    int hudHealth{-1};
+    int hudEnemies{-1};
+    JobSystem jobs;
+    // a replay brings the seed the World is built with
+    InputPlayer replay;
+    unsigned int seed{};
+    InputRecorder recorder;
+    World world;
+    // the World right after setup, restored to play again
+    Snapshot initialState;
+
+    // simulation time not yet stepped, always less than one FIXED_TIME_STEP
+    float accumulator{};
+    // presses since the last step, so none is lost on frames that do not step
+    unsigned pendingPressed{};
+
+    void loadGameplayAssets();
+    void setScene(Scene next);
+    void updateTitle(float frameTime);
+    void updatePlaying(float frameTime);
+    void updateGameOver();
+    // end screens: Enter starts a new round without reloading anything
+    void offerRestart();
+    void restart();
+    void drawHud();
+#if defined(ENABLE_PROFILER)
+    // F3 toggles the profiler overlay, F4 records the next frames and saves
+    // (web: downloads) them as a trace. Zones are only recorded meanwhile
+    bool showProfiler{false};
+    int captureFrames{};
+    void updateProfiler();
+    void endProfilerFrame();
+#endif
+};
+
+#endif
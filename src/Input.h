@@ -0,0 +1,24 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+// Player input for one simulation step, as a bitmask of buttons.
+// The front end fills this from the keyboard (or joystick); the
+// simulation never reads a device directly.
+enum InputButton : unsigned
+{
+    INPUT_LEFT   = 1u << 0,
+    INPUT_RIGHT  = 1u << 1,
+    INPUT_UP     = 1u << 2,
+    INPUT_DOWN   = 1u << 3,
+    INPUT_ATTACK = 1u << 4
+};
+
+const unsigned INPUT_MOVE_MASK{INPUT_LEFT | INPUT_RIGHT | INPUT_UP | INPUT_DOWN};
+
+struct WorldInput
+{
+    unsigned held{};    // buttons down during this step
+    unsigned pressed{}; // buttons that went down this step
+};
+
+#endif
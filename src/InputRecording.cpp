@@ -0,0 +1,178 @@
+#include "InputRecording.h"
+
+const char RECORDING_MAGIC[4]{'A', 'R', 'P', 'L'};
+const unsigned char RECORDING_VERSION{1};
+// bits of held (and of pressed) in the packed input
+const unsigned INPUT_BITS{5};
+const unsigned INPUT_MASK{(1u << INPUT_BITS) - 1u};
+
+static void writeU16(std::FILE* file, unsigned value)
+{
+    std::fputc(value & 0xff, file);
+    std::fputc((value >> 8) & 0xff, file);
+}
+
+static void writeU32(std::FILE* file, unsigned long value)
+{
+    writeU16(file, value & 0xffff);
+    writeU16(file, (value >> 16) & 0xffff);
+}
+
+static void writeVarint(std::FILE* file, unsigned long value)
+{
+    while (value >= 0x80)
+    {
+        std::fputc(static_cast<int>((value & 0x7f) | 0x80), file);
+        value >>= 7;
+    }
+    std::fputc(static_cast<int>(value), file);
+}
+
+static bool readU16(std::FILE* file, unsigned& value)
+{
+    int low = std::fgetc(file);
+    int high = std::fgetc(file);
+    if (low == EOF || high == EOF)
+        return false;
+    value = static_cast<unsigned>(low) | (static_cast<unsigned>(high) << 8);
+    return true;
+}
+
+static bool readU32(std::FILE* file, unsigned long& value)
+{
+    unsigned low, high;
+    if (!readU16(file, low) || !readU16(file, high))
+        return false;
+    value = low | (static_cast<unsigned long>(high) << 16);
+    return true;
+}
+
+static bool readVarint(std::FILE* file, unsigned long& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        int byte = std::fgetc(file);
+        if (byte == EOF)
+            return false;
+        value |= static_cast<unsigned long>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+InputRecorder::~InputRecorder()
+{
+    close();
+}
+
+bool InputRecorder::open(const char* path, unsigned int seed, int viewWidth, int viewHeight)
+{
+    close();
+    file = std::fopen(path, "wb");
+    if (!file)
+        return false;
+
+    std::fwrite(RECORDING_MAGIC, 1, sizeof(RECORDING_MAGIC), file);
+    std::fputc(RECORDING_VERSION, file);
+    writeU16(file, static_cast<unsigned>(viewWidth));
+    writeU16(file, static_cast<unsigned>(viewHeight));
+    writeU32(file, seed);
+    current = 0;
+    previous = 0;
+    runLength = 0;
+    return true;
+}
+
+void InputRecorder::record(const WorldInput& input)
+{
+    if (!file)
+        return;
+    unsigned packed = (input.held & INPUT_MASK) | ((input.pressed & INPUT_MASK) << INPUT_BITS);
+    if (runLength > 0 && packed != current)
+        writeRun();
+    current = packed;
+    runLength++;
+}
+
+void InputRecorder::writeRun()
+{
+    writeVarint(file, runLength);
+    writeVarint(file, current ^ previous);
+    previous = current;
+    runLength = 0;
+}
+
+void InputRecorder::close()
+{
+    if (!file)
+        return;
+    if (runLength > 0)
+        writeRun();
+    std::fclose(file);
+    file = nullptr;
+}
+
+InputPlayer::~InputPlayer()
+{
+    close();
+}
+
+bool InputPlayer::open(const char* path)
+{
+    close();
+    file = std::fopen(path, "rb");
+    if (!file)
+        return false;
+
+    char magic[sizeof(RECORDING_MAGIC)]{};
+    unsigned width, height;
+    unsigned long fileSeed;
+    bool valid = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 magic[0] == RECORDING_MAGIC[0] && magic[1] == RECORDING_MAGIC[1] &&
+                 magic[2] == RECORDING_MAGIC[2] && magic[3] == RECORDING_MAGIC[3] &&
+                 std::fgetc(file) == RECORDING_VERSION &&
+                 readU16(file, width) && readU16(file, height) && readU32(file, fileSeed);
+    if (!valid)
+    {
+        close();
+        return false;
+    }
+
+    seed = static_cast<unsigned int>(fileSeed);
+    viewWidth = static_cast<int>(width);
+    viewHeight = static_cast<int>(height);
+    current = 0;
+    runLeft = 0;
+    step = 0;
+    return true;
+}
+
+bool InputPlayer::next(WorldInput& input)
+{
+    if (!file)
+        return false;
+    if (runLeft == 0)
+    {
+        unsigned long change;
+        if (!readVarint(file, runLeft) || runLeft == 0 || !readVarint(file, change))
+        {
+            close();
+            return false;
+        }
+        current ^= static_cast<unsigned>(change);
+    }
+    runLeft--;
+    step++;
+    input.held = current & INPUT_MASK;
+    input.pressed = (current >> INPUT_BITS) & INPUT_MASK;
+    return true;
+}
+
+void InputPlayer::close()
+{
+    if (file)
+        std::fclose(file);
+    file = nullptr;
+}
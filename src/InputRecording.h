@@ -0,0 +1,69 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include "Input.h"
+#include <cstdio>
+
+// Compact binary recording of a play session: what the World was built
+// with (seed and view size) and the WorldInput of every step, stored as
+// runs of identical steps, each as the step count and the change (xor)
+// from the previous run's input. Holding a direction for ten seconds costs
+// a few bytes. Feeding the steps back into a World built the same way
+// repeats the session exactly (the simulation is deterministic).
+//
+// Layout, little-endian, varints are LEB128:
+//   "ARPL"  u8 version  u16 viewWidth  u16 viewHeight  u32 seed
+//   runs until the end of the file: varint steps, varint input xor previous
+// where input is held | pressed << INPUT_BITS.
+class InputRecorder
+{
+public:
+    InputRecorder() = default;
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+    ~InputRecorder();
+    // start a new file; false if it can not be created
+    bool open(const char* path, unsigned int seed, int viewWidth, int viewHeight);
+    bool isOpen() const { return file != nullptr; }
+    // append one step's input
+    void record(const WorldInput& input);
+    // write the pending run and close the file
+    void close();
+private:
+    std::FILE* file{nullptr};
+    unsigned current{};
+    unsigned previous{};
+    unsigned long runLength{};
+
+    void writeRun();
+};
+
+class InputPlayer
+{
+public:
+    InputPlayer() = default;
+    InputPlayer(const InputPlayer&) = delete;
+    InputPlayer& operator=(const InputPlayer&) = delete;
+    ~InputPlayer();
+    // false if the file is missing or not a recording
+    bool open(const char* path);
+    bool isOpen() const { return file != nullptr; }
+    unsigned int getSeed() const { return seed; }
+    int getViewWidth() const { return viewWidth; }
+    int getViewHeight() const { return viewHeight; }
+    // the next step's input, false (and closed) once the recording is over
+    bool next(WorldInput& input);
+    // steps handed out so far
+    long getStep() const { return step; }
+    void close();
+private:
+    std::FILE* file{nullptr};
+    unsigned int seed{};
+    int viewWidth{};
+    int viewHeight{};
+    unsigned current{};
+    unsigned long runLeft{};
+    long step{};
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "JobSystem.h"
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    #define JOB_SYSTEM_NO_THREADS
+#endif
+
+JobSystem::JobSystem(int workerCount)
+{
+#if defined(JOB_SYSTEM_NO_THREADS)
+    workerCount = 0;
+#else
+    if (workerCount < 0)
+    {
+        int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+#endif
+
+    for (int i = 0; i <= workerCount; i++)
+        queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    for (int i = 1; i <= workerCount; i++)
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void JobSystem::run(int jobCount, const std::function<void(int)>& job)
+{
+    if (jobCount <= 0)
+        return;
+
+    if (workers.empty() || jobCount == 1)
+    {
+        for (int i = 0; i < jobCount; i++)
+            job(i);
+        return;
+    }
+
+    currentJob = &job;
+    pending.store(jobCount);
+
+    // deal the jobs out round-robin, neighbours end up on different threads
+    const int queueCount = static_cast<int>(queues.size());
+    for (int q = 0; q < queueCount; q++)
+    {
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (int i = q; i < jobCount; i += queueCount)
+            queues[q]->jobs.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        generation++;
+    }
+    wake.notify_all();
+
+    // the caller works too, then waits for the stragglers
+    while (runOne(0)) {}
+    {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        done.wait(lock, [this] { return pending.load() == 0; });
+    }
+
+    currentJob = nullptr;
+}
+
+bool JobSystem::runOne(int queueIndex)
+{
+    int jobIndex{-1};
+    {
+        // own work first, newest first
+        Queue& own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            jobIndex = own.jobs.back();
+            own.jobs.pop_back();
+        }
+    }
+
+    // then steal the oldest job of another thread
+    const int queueCount = static_cast<int>(queues.size());
+    for (int offset = 1; jobIndex < 0 && offset < queueCount; offset++)
+    {
+        Queue& victim = *queues[(queueIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            jobIndex = victim.jobs.front();
+            victim.jobs.pop_front();
+        }
+    }
+
+    if (jobIndex < 0)
+        return false;
+
+    (*currentJob)(jobIndex);
+    if (pending.fetch_sub(1) == 1)
+    {
+        // under the lock, so the caller cannot miss it between its check and
+        // going to sleep
+        std::lock_guard<std::mutex> lock(doneMutex);
+        done.notify_one();
+    }
+    return true;
+}
+
+void JobSystem::workerLoop(int queueIndex)
+{
+    unsigned seenGeneration{0};
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping)
+                return;
+            seenGeneration = generation;
+        }
+
+        while (runOne(queueIndex)) {}
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fork-join job system for the desktop build. Every thread (the
+// workers plus the caller of run()) owns a deque of job indices: it takes
+// work from the back of its own deque and steals from the front of the
+// others' when it runs dry. The caller sleeps only once every job has been
+// taken. Without thread support (the web build has no pthreads) everything
+// runs on the caller.
+class JobSystem
+{
+public:
+    // workerCount < 0 picks one worker per extra hardware thread
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // workers plus the calling thread
+    int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+    // calls job(index) for every index in [0, jobCount) and returns when all
+    // of them are done. Which thread runs which index is not fixed, so jobs
+    // must only write their own outputs.
+    void run(int jobCount, const std::function<void(int)>& job);
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<int> jobs;
+    };
+
+    std::vector<std::thread> workers;
+    // queues[0] belongs to the thread calling run()
+    std::vector<std::unique_ptr<Queue>> queues;
+    const std::function<void(int)>* currentJob{nullptr};
+    std::atomic<int> pending{0};
+    // the caller sleeps here once no job is left to take
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    unsigned generation{0};
+    bool stopping{false};
+
+    void workerLoop(int queueIndex);
+    bool runOne(int queueIndex);
+};
+
+#endif
@@ -0,0 +1,117 @@
+#include "MusicPlayer.h"
+#include <string>
+
+// Frames per stream buffer (about 93 ms at 44.1 kHz); raylib keeps two of
+// these per stream and decodes into them as they drain
+const int MUSIC_STREAM_BUFFER_FRAMES{4096};
+
+MusicPlayer::~MusicPlayer()
+{
+    for (auto& track : tracks)
+        if (track.loaded)
+            UnloadMusicStream(track.music);
+}
+
+bool MusicPlayer::load(MusicTrack track, const char* pathStem)
+{
+    // compressed sources first, they are smaller to ship and to stream
+    const char* extensions[]{".ogg", ".mp3", ".wav"};
+
+    Track& slot = tracks[track];
+    if (slot.loaded)
+        UnloadMusicStream(slot.music);
+    slot = Track{};
+
+    for (const char* extension : extensions)
+    {
+        std::string path = std::string(pathStem) + extension;
+        if (!FileExists(path.c_str()))
+            continue;
+
+        SetAudioStreamBufferSizeDefault(MUSIC_STREAM_BUFFER_FRAMES);
+        slot.music = LoadMusicStream(path.c_str());
+        SetAudioStreamBufferSizeDefault(0);
+
+        slot.loaded = slot.music.frameCount > 0;
+        if (slot.loaded)
+        {
+            slot.music.looping = true;
+            return true;
+        }
+    }
+
+    TraceLog(LOG_WARNING, "MUSIC: No playable file for \"%s\"", pathStem);
+    return false;
+}
+
+void MusicPlayer::play(MusicTrack track, float fadeSeconds)
+{
+    float rate = fadeSeconds > 0.f ? 1.f / fadeSeconds : 0.f;
+
+    for (int i = 0; i < MUSIC_TRACK_COUNT; i++)
+    {
+        Track& slot = tracks[i];
+        if (!slot.loaded)
+            continue;
+
+        if (i == track)
+        {
+            if (!slot.playing)
+            {
+                PlayMusicStream(slot.music);
+                slot.playing = true;
+                slot.volume = rate > 0.f ? 0.f : 1.f;
+            }
+            slot.targetVolume = 1.f;
+        }
+        else
+        {
+            slot.targetVolume = 0.f;
+            if (rate <= 0.f)
+                slot.volume = 0.f;
+        }
+        slot.fadeRate = rate;
+        SetMusicVolume(slot.music, slot.volume);
+    }
+}
+
+void MusicPlayer::stop()
+{
+    for (auto& track : tracks)
+    {
+        if (track.playing)
+            StopMusicStream(track.music);
+        track.playing = false;
+        track.volume = 0.f;
+        track.targetVolume = 0.f;
+    }
+}
+
+void MusicPlayer::update(float deltaTime)
+{
+    for (auto& track : tracks)
+    {
+        if (!track.playing)
+            continue;
+
+        if (track.volume != track.targetVolume)
+        {
+            float step = track.fadeRate > 0.f ? track.fadeRate * deltaTime : 1.f;
+            if (track.volume < track.targetVolume)
+                track.volume = track.volume + step > track.targetVolume ? track.targetVolume : track.volume + step;
+            else
+                track.volume = track.volume - step < track.targetVolume ? track.targetVolume : track.volume - step;
+            SetMusicVolume(track.music, track.volume);
+        }
+
+        // faded out completely
+        if (track.volume <= 0.f && track.targetVolume <= 0.f)
+        {
+            StopMusicStream(track.music);
+            track.playing = false;
+            continue;
+        }
+
+        UpdateMusicStream(track.music);
+    }
+}
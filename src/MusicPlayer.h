@@ -0,0 +1,45 @@
+#ifndef MUSIC_PLAYER_H
+#define MUSIC_PLAYER_H
+
+#include "raylib.h"
+
+enum MusicTrack
+{
+    MUSIC_TITLE,
+    MUSIC_GAMEPLAY,
+    MUSIC_TRACK_COUNT
+};
+
+// Background music streamed from disk through a small ring buffer instead of
+// being decoded whole into a Sound. Tracks loop, and switching tracks
+// crossfades between them. Needs the audio device for its whole lifetime.
+class MusicPlayer
+{
+public:
+    MusicPlayer() = default;
+    ~MusicPlayer();
+    MusicPlayer(const MusicPlayer&) = delete;
+    MusicPlayer& operator=(const MusicPlayer&) = delete;
+
+    // pathStem has no extension: the first of .ogg, .mp3, .wav found is used
+    bool load(MusicTrack track, const char* pathStem);
+    // fade the current track out and this one in over fadeSeconds
+    void play(MusicTrack track, float fadeSeconds);
+    void stop();
+    // refill the stream buffers and advance fades, call once per frame
+    void update(float deltaTime);
+private:
+    struct Track
+    {
+        Music music{};
+        bool loaded{false};
+        bool playing{false};
+        float volume{};
+        float targetVolume{};
+        // volume change per second while fading
+        float fadeRate{};
+    };
+    Track tracks[MUSIC_TRACK_COUNT]{};
+};
+
+#endif
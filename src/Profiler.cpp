@@ -0,0 +1,216 @@
+#include "Profiler.h"
+
+#if defined(ENABLE_PROFILER)
+
+#include <chrono>
+#include <cstdio>
+
+// frames in the rolling averages
+const int PROFILER_HISTORY{60};
+// events kept per thread for the trace, the oldest are overwritten (a few
+// seconds of frames on the main thread, about 330 KB per recording thread)
+const size_t PROFILER_THREAD_EVENTS{1u << 13};
+
+// oldest event still in a ring that has had written events pushed
+static size_t firstKept(size_t written)
+{
+    return written > PROFILER_THREAD_EVENTS ? written - PROFILER_THREAD_EVENTS : 0;
+}
+
+Profiler& Profiler::get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+long long Profiler::nowNanos()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::start()
+{
+    recording = true;
+}
+
+void Profiler::stop()
+{
+    recording = false;
+}
+
+void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto& buffer : buffers)
+    {
+        buffer->written.store(0, std::memory_order_relaxed);
+        buffer->folded = 0;
+    }
+    zones.clear();
+    zoneStats.clear();
+    counterStats.clear();
+}
+
+Profiler::ThreadBuffer& Profiler::localBuffer()
+{
+    // allocated on the thread's first event, so threads that never record
+    // (or builds that never start the profiler) cost nothing
+    thread_local ThreadBuffer* buffer{nullptr};
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+        buffer = buffers.back().get();
+        buffer->thread = static_cast<int>(buffers.size()) - 1;
+        buffer->events.resize(PROFILER_THREAD_EVENTS);
+    }
+    return *buffer;
+}
+
+void Profiler::beginFrame()
+{
+    frameStart = nowNanos();
+}
+
+void Profiler::endFrame()
+{
+    if (!isRecording())
+        return;
+    long long frameEnd = nowNanos();
+    record("Frame", frameStart, frameEnd);
+    frameMs = (frameEnd - frameStart) / 1000000.f;
+
+    // this frame's zones of every thread
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (auto& buffer : buffers)
+        {
+            size_t written = buffer->written.load(std::memory_order_acquire);
+            size_t first = firstKept(written);
+            for (size_t i = buffer->folded > first ? buffer->folded : first; i < written; i++)
+            {
+                const Event& event = buffer->events[i % PROFILER_THREAD_EVENTS];
+                if (event.counter)
+                    continue;
+                ZoneHistory& zone = findZone(event.name);
+                zone.frameTotal += event.duration / 1000000.f;
+                zone.frameCalls++;
+            }
+            buffer->folded = written;
+        }
+    }
+
+    // fold this frame into every zone's history, zones that did not run
+    // this frame count as 0 ms
+    zoneStats.clear();
+    for (auto& zone : zones)
+    {
+        zone.frames[historyIndex] = zone.frameTotal;
+        zone.calls = zone.frameCalls;
+        zone.frameTotal = 0.f;
+        zone.frameCalls = 0;
+
+        float sum{};
+        for (float ms : zone.frames)
+            sum += ms;
+        zoneStats.push_back(ZoneStats{zone.name, sum / PROFILER_HISTORY, zone.calls});
+    }
+    historyIndex = (historyIndex + 1) % PROFILER_HISTORY;
+}
+
+Profiler::ZoneHistory& Profiler::findZone(const char* name)
+{
+    // names are literals, the pointer identifies the zone
+    for (auto& zone : zones)
+        if (zone.name == name)
+            return zone;
+    zones.push_back(ZoneHistory{});
+    zones.back().name = name;
+    zones.back().frames.assign(PROFILER_HISTORY, 0.f);
+    return zones.back();
+}
+
+void Profiler::pushEvent(const Event& event)
+{
+    ThreadBuffer& buffer = localBuffer();
+    size_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % PROFILER_THREAD_EVENTS] = event;
+    buffer.events[index % PROFILER_THREAD_EVENTS].thread = buffer.thread;
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::record(const char* name, long long startNanos, long long endNanos)
+{
+    Event event{};
+    event.name = name;
+    event.start = startNanos;
+    event.duration = endNanos - startNanos;
+    pushEvent(event);
+}
+
+void Profiler::setCounter(const char* name, int value)
+{
+    if (!isRecording())
+        return;
+
+    Event event{};
+    event.name = name;
+    event.start = nowNanos();
+    event.value = value;
+    event.counter = true;
+    pushEvent(event);
+
+    for (auto& counter : counterStats)
+    {
+        if (counter.name == name)
+        {
+            counter.value = value;
+            return;
+        }
+    }
+    counterStats.push_back(CounterStats{name, value});
+}
+
+std::string Profiler::buildTrace() const
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    std::string json = "{\"traceEvents\":[\n";
+    char line[256];
+    const char* separator = "";
+    // trace_event timestamps are microseconds; the viewers order the
+    // threads' events themselves
+    for (const auto& buffer : buffers)
+    {
+        size_t written = buffer->written.load(std::memory_order_acquire);
+        for (size_t i = firstKept(written); i < written; i++)
+        {
+            const Event& event = buffer->events[i % PROFILER_THREAD_EVENTS];
+            if (event.counter)
+                std::snprintf(line, sizeof(line),
+                              "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"value\":%d}}",
+                              separator, event.name, event.start / 1000.0, event.thread, event.value);
+            else
+                std::snprintf(line, sizeof(line),
+                              "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                              separator, event.name, event.start / 1000.0, event.duration / 1000.0, event.thread);
+            json += line;
+            separator = ",\n";
+        }
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return json;
+}
+
+bool Profiler::writeTrace(const char* path) const
+{
+    std::string json = buildTrace();
+    FILE* file = std::fopen(path, "wb");
+    if (!file)
+        return false;
+    bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    std::fclose(file);
+    return written;
+}
+
+#endif
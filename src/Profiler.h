@@ -0,0 +1,153 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Frame profiler: scoped zones time a block of code, the results feed a
+// rolling per-zone average (the F3 overlay in Game) and a Chrome
+// trace_event JSON file (chrome://tracing or ui.perfetto.dev).
+//
+//   void World::step(...)
+//   {
+//       PROFILE_ZONE("World::step");
+//       ...
+//
+// Zones only exist when the build defines ENABLE_PROFILER (make PROFILER=TRUE);
+// otherwise PROFILE_ZONE and PROFILE_COUNTER expand to nothing. Zone names
+// must be string literals. Needs no window, so the simulation core can use it.
+//
+// Every thread records into a ring buffer of its own, without locks. The
+// buffers are read (endFrame, buildTrace) on the thread running the frames,
+// between frames, when no job is running on the other threads.
+
+#if defined(ENABLE_PROFILER)
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Profiler
+{
+public:
+    struct ZoneStats
+    {
+        const char* name{};
+        // mean time per frame over the last PROFILER_HISTORY frames
+        float averageMs{};
+        int calls{};
+    };
+    struct CounterStats
+    {
+        const char* name{};
+        int value{};
+    };
+
+    static Profiler& get();
+
+    // zones are only recorded between start() and stop()
+    void start();
+    void stop();
+    // forget every recorded event and the averages
+    void clear();
+    bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+
+    // frame boundaries for the rolling averages and the trace
+    void beginFrame();
+    void endFrame();
+
+    // called by ProfileZone, safe from any thread
+    void record(const char* name, long long startNanos, long long endNanos);
+    // from the thread running the frames only
+    void setCounter(const char* name, int value);
+    static long long nowNanos();
+
+    const std::vector<ZoneStats>& getZoneStats() const { return zoneStats; }
+    const std::vector<CounterStats>& getCounters() const { return counterStats; }
+    float getFrameMs() const { return frameMs; }
+
+    // every recorded event still in the buffer, as trace_event JSON
+    std::string buildTrace() const;
+    bool writeTrace(const char* path) const;
+private:
+    struct Event
+    {
+        const char* name{};
+        // nanoseconds
+        long long start{};
+        long long duration{};
+        int thread{};
+        // counters are events too, with a value and no duration
+        int value{};
+        bool counter{false};
+    };
+    // one thread's events; the ring keeps the last PROFILER_THREAD_EVENTS
+    struct ThreadBuffer
+    {
+        int thread{};
+        std::vector<Event> events;
+        // events pushed so far, published to the reading thread
+        std::atomic<size_t> written{0};
+        // events already folded into the averages (reading thread only)
+        size_t folded{};
+    };
+    struct ZoneHistory
+    {
+        const char* name{};
+        std::vector<float> frames;
+        float frameTotal{};
+        int frameCalls{};
+        int calls{};
+    };
+
+    Profiler() = default;
+
+    std::atomic<bool> recording{false};
+    // guards the list of buffers, taken once per thread and by the reader
+    mutable std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    long long frameStart{};
+    int historyIndex{};
+    float frameMs{};
+    std::vector<ZoneHistory> zones;
+    std::vector<ZoneStats> zoneStats;
+    std::vector<CounterStats> counterStats;
+
+    ThreadBuffer& localBuffer();
+    void pushEvent(const Event& event);
+    ZoneHistory& findZone(const char* name);
+};
+
+// times its enclosing scope
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* zoneName):
+        name(zoneName),
+        start(Profiler::get().isRecording() ? Profiler::nowNanos() : -1)
+    {
+    }
+    ~ProfileZone()
+    {
+        if (start >= 0)
+            Profiler::get().record(name, start, Profiler::nowNanos());
+    }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+private:
+    const char* name;
+    long long start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_COUNTER(name, value) Profiler::get().setCounter(name, value)
+
+#else
+
+#define PROFILE_ZONE(name)
+#define PROFILE_COUNTER(name, value)
+
+#endif
+
+#endif
@@ -1,27 +1,34 @@
 #include "Prop.h"
-#include "raymath.h"
+#include "SpriteData.h"
 
-Prop::Prop(Vector2 pos, Texture2D tex, float objectSize):
+Prop::Prop(Vector2 pos, PropType propType, float objectSize):
     worldPos(pos),
-    texture(tex),
+    type(propType),
     scale(objectSize)
 {
-
-}
-
-void Prop::Render(Vector2 knightPos)
-{
-    Vector2 screenPos{ Vector2Subtract(worldPos, knightPos) };
-    DrawTextureEx(texture, screenPos, 0.f, scale, WHITE);
+    switch(type)
+    {
+        case ROCK:
+            width = ROCK_WIDTH;
+            height = ROCK_HEIGHT;
+            break;
+        case SIGN:
+            width = SIGN_WIDTH;
+            height = SIGN_HEIGHT;
+            break;
+        case LOG:
+            width = LOG_WIDTH;
+            height = LOG_HEIGHT;
+            break;
+    }
 }
 
-Rectangle Prop::getCollisionRec(Vector2 knightPos)
+Rectangle Prop::getWorldCollisionRec() const
 {
-    Vector2 screenPos{ Vector2Subtract(worldPos, knightPos) };
     return Rectangle{
-        screenPos.x ,
-        screenPos.y ,
-        texture.width * scale,
-        texture.height * scale
+        worldPos.x,
+        worldPos.y,
+        width * scale,
+        height * scale
     };
 }
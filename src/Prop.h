@@ -1,13 +1,24 @@
+#ifndef PROP_H
+#define PROP_H
+
 #include "raylib.h"
 
 class Prop
 {
 public:
-    Prop(Vector2 pos, Texture2D tex, float objectSize);
-    void Render(Vector2 knightPos);
-    Rectangle getCollisionRec(Vector2 knightPos);
+    enum PropType { ROCK, SIGN, LOG };
+
+    Prop(Vector2 pos, PropType propType, float objectSize);
+    Rectangle getWorldCollisionRec() const;
+    Vector2 getWorldPos() const { return worldPos; }
+    PropType getType() const { return type; }
+    float getScale() const { return scale; }
 private:
     Vector2 worldPos{};
-    Texture2D texture{};
+    PropType type{ROCK};
+    float width{};
+    float height{};
     float scale{};
 };
+
+#endif
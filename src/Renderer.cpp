@@ -0,0 +1,221 @@
+#include "Renderer.h"
+#include "AtlasData.h"
+#include "SpriteData.h"
+#include "raymath.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+Renderer::Renderer(AssetCache& assets):
+    // Preload all textures to prevent flickering in web builds
+    Renderer(assets.getTexture(ATLAS_IMAGE_PATH), assets.getTexture("nature_tileset/DesertWorldMap_2_24x24.png"))
+{
+
+}
+
+Renderer::Renderer(TextureHandle atlas, TextureHandle map):
+    atlasTexture(atlas),
+    mapTexture(map)
+{
+
+}
+
+// atlas sheets of each enemy type, in EnemyPool::EnemyType order
+struct EnemySprites
+{
+    Rectangle idle;
+    Rectangle run;
+};
+const EnemySprites ENEMY_SPRITES[]{
+    {ATLAS_GOBLIN_IDLE, ATLAS_GOBLIN_RUN},                                  // GOBLIN
+    {ATLAS_SLIME_IDLE, ATLAS_SLIME_RUN},                                    // SLIME
+    {ATLAS_INTELLECT_DEVOURER_IDLE_SIDE, ATLAS_INTELLECT_DEVOURER_IDLE_SIDE}, // INTELLECT_DEVOURER
+    {ATLAS_GOBLIN_IDLE, ATLAS_GOBLIN_RUN},                                  // ELITE_GOBLIN
+    {ATLAS_SLIME_IDLE, ATLAS_SLIME_RUN},                                    // SLIME_KING
+};
+static_assert(sizeof(ENEMY_SPRITES) / sizeof(ENEMY_SPRITES[0]) == EnemyPool::ENEMY_TYPE_COUNT,
+              "one ENEMY_SPRITES entry per EnemyType");
+
+// enemies are culled at their simulated position, which can be a step
+// ahead of the drawn one
+const float CULL_MARGIN{32.f};
+// screen pixels per art pixel: sprites and map are drawn at scale 4
+const int PIXEL_SCALE{4};
+
+Renderer::~Renderer()
+{
+    if (lowResTarget.id != 0)
+        UnloadRenderTexture(lowResTarget);
+}
+
+void Renderer::setLowResolution(bool enabled)
+{
+    lowResolution = enabled;
+    if (enabled && lowResTarget.id == 0)
+    {
+        // round up so the upscaled target covers the whole screen
+        lowResTarget = LoadRenderTexture((GetScreenWidth() + PIXEL_SCALE - 1) / PIXEL_SCALE,
+                                         (GetScreenHeight() + PIXEL_SCALE - 1) / PIXEL_SCALE);
+        SetTextureFilter(lowResTarget.texture, TEXTURE_FILTER_POINT);
+    }
+}
+
+void Renderer::drawWorld(const World& world, float alpha)
+{
+    PROFILE_ZONE("Renderer::drawWorld");
+    Vector2 knightPos = world.getCameraPos(alpha);
+    // the screen in world coordinates (the knight's worldPos is the camera)
+    buildDrawList(world, alpha, Rectangle{knightPos.x, knightPos.y,
+                                          static_cast<float>(GetScreenWidth()), static_cast<float>(GetScreenHeight())});
+
+    if (!lowResolution)
+    {
+        PROFILE_ZONE("DrawList::submit");
+        drawList.submit();
+        return;
+    }
+
+    {
+        PROFILE_ZONE("DrawList::submit");
+        // the same screen-space rects, scaled down by the camera
+        Camera2D pixelCamera{};
+        pixelCamera.zoom = 1.f / PIXEL_SCALE;
+        BeginTextureMode(lowResTarget);
+        ClearBackground(BLANK);
+        BeginMode2D(pixelCamera);
+        drawList.submit();
+        EndMode2D();
+        EndTextureMode();
+    }
+    {
+        PROFILE_ZONE("Renderer::upscale");
+        const Texture2D& target = lowResTarget.texture;
+        // render textures are stored upside down
+        Rectangle source{0.f, 0.f, static_cast<float>(target.width), -static_cast<float>(target.height)};
+        Rectangle dest{0.f, 0.f, static_cast<float>(target.width * PIXEL_SCALE),
+                       static_cast<float>(target.height * PIXEL_SCALE)};
+        DrawTexturePro(target, source, dest, Vector2{}, 0.f, WHITE);
+    }
+}
+
+void Renderer::buildDrawList(const World& world, float alpha, Rectangle view)
+{
+    const Character& knight = world.getKnight();
+    Vector2 knightPos{view.x, view.y};
+
+    drawList.clear();
+
+    queueMap(knightPos, view);
+
+    // the props
+    world.queryProps(view, visibleProps);
+    for (int index : visibleProps)
+        queueProp(world.getProps()[index], knightPos);
+
+    // the end screens only show the map
+    if (!world.isGameOver() && !world.isVictory())
+    {
+        queueCharacter(knight, ATLAS_KNIGHT_IDLE, ATLAS_KNIGHT_RUN);
+        queueWeapon(knight);
+
+        Rectangle enemyView{view.x - CULL_MARGIN, view.y - CULL_MARGIN,
+                            view.width + 2.f * CULL_MARGIN, view.height + 2.f * CULL_MARGIN};
+        world.queryEnemies(enemyView, visibleEnemies);
+        queueEnemies(world.getEnemies(), knightPos, alpha);
+    }
+
+    {
+        PROFILE_ZONE("DrawList::sort");
+        drawList.sort();
+    }
+}
+
+// Only the part of the map under the screen, snapped to whole texels so the
+// scaled pixels land exactly where a full-map draw would put them
+void Renderer::queueMap(Vector2 knightPos, Rectangle view)
+{
+    const Texture2D& map = *mapTexture;
+    float left = std::max(std::floor(view.x / MAP_SCALE), 0.f);
+    float top = std::max(std::floor(view.y / MAP_SCALE), 0.f);
+    float right = std::min(std::ceil((view.x + view.width) / MAP_SCALE), static_cast<float>(map.width));
+    float bottom = std::min(std::ceil((view.y + view.height) / MAP_SCALE), static_cast<float>(map.height));
+    if (right <= left || bottom <= top)
+        return;
+
+    Rectangle source{left, top, right - left, bottom - top};
+    Rectangle dest{left * MAP_SCALE - knightPos.x, top * MAP_SCALE - knightPos.y,
+                   source.width * MAP_SCALE, source.height * MAP_SCALE};
+    drawList.push(LAYER_MAP, map, source, dest);
+}
+
+void Renderer::queueCharacter(const BaseCharacter& character, Rectangle idle, Rectangle run)
+{
+    float width = character.getWidth();
+    float height = character.getHeight();
+    float scale = character.getScale();
+    Vector2 screenPos = character.getScreenPos();
+
+    Rectangle sheet = character.getRunning() ? run : idle;
+    Rectangle source{sheet.x + character.getFrame() * width, sheet.y, character.getRightLeft() * width, height};
+    Rectangle dest{screenPos.x, screenPos.y, scale * width, scale * height};
+    drawList.push(LAYER_CHARACTERS, *atlasTexture, source, dest);
+}
+
+void Renderer::queueEnemies(const EnemyPool& enemies, Vector2 cameraPos, float alpha)
+{
+    const float width{CHARACTER_FRAME_WIDTH};
+    const float height{CHARACTER_FRAME_HEIGHT};
+    const float scale{4.f};
+
+    for (int i : visibleEnemies)
+    {
+        const EnemySprites& sprites = ENEMY_SPRITES[enemies.getType(i)];
+        Vector2 screenPos = Vector2Subtract(enemies.getRenderPos(i, alpha), cameraPos);
+        Rectangle sheet = enemies.getRunning(i) ? sprites.run : sprites.idle;
+        Rectangle source{sheet.x + enemies.getFrame(i) * width, sheet.y, enemies.getRightLeft(i) * width, height};
+        Rectangle dest{screenPos.x, screenPos.y, scale * width, scale * height};
+        drawList.push(LAYER_CHARACTERS, *atlasTexture, source, dest);
+    }
+}
+
+void Renderer::queueWeapon(const Character& knight)
+{
+    const Rectangle weapon = ATLAS_WEAPON_LASER_SWORD;
+    float scale = knight.getScale();
+    Vector2 screenPos = knight.getScreenPos();
+    Vector2 origin{};
+    Vector2 offset{};
+    float rotation{};
+
+    if (knight.getRightLeft() > 0.f)
+    {
+        origin = {0.f, weapon.height * scale};
+        offset = {45.f, 70.f};
+        rotation = knight.isAttacking() ? 35.f : 0.f;
+    }
+    else
+    {
+        origin = {weapon.width * scale, weapon.height * scale};
+        offset = {35.f, 70.f};
+        rotation = knight.isAttacking() ? -35.f : 0.f;
+    }
+
+    // the sworde
+    Rectangle source{weapon.x, weapon.y, weapon.width * knight.getRightLeft(), weapon.height};
+    Rectangle dest{screenPos.x + offset.x, screenPos.y + offset.y, weapon.width * 3.f, weapon.height * 3.f};
+    drawList.push(LAYER_WEAPON, *atlasTexture, source, dest, origin, rotation);
+}
+
+void Renderer::queueProp(const Prop& prop, Vector2 knightPos)
+{
+    Rectangle source{};
+    switch(prop.getType())
+    {
+        case Prop::ROCK: source = ATLAS_ROCK; break;
+        case Prop::SIGN: source = ATLAS_SIGN; break;
+        case Prop::LOG: source = ATLAS_LOG; break;
+    }
+    Vector2 screenPos{ Vector2Subtract(prop.getWorldPos(), knightPos) };
+    Rectangle dest{screenPos.x, screenPos.y, source.width * prop.getScale(), source.height * prop.getScale()};
+    drawList.push(LAYER_PROPS, *atlasTexture, source, dest);
+}
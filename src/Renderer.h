@@ -0,0 +1,58 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "raylib.h"
+#include "AssetCache.h"
+#include "World.h"
+#include "DrawList.h"
+#include <vector>
+
+// Owns the game textures and draws a World. Needs an open window.
+// Runs after the simulation step: every sprite is queued in a DrawList,
+// sorted by layer and texture, then submitted in one pass. Only what
+// overlaps the screen is queued: the map as the sub-rect under the
+// viewport, props and enemies through the World's broadphase grids.
+//
+// With low resolution on, the sprites land in a render texture at the
+// art's own pixel size (1/PIXEL_SCALE of the screen per axis) that is then
+// scaled up to the screen in one nearest-filtered blit: a sixteenth of the
+// fill for the same picture. Whatever is drawn after drawWorld (the HUD)
+// stays at full resolution.
+class Renderer
+{
+public:
+    explicit Renderer(AssetCache& assets);
+    // with textures loaded elsewhere (buildDrawList only needs their ids
+    // and the map's size, so the benchmarks pass stand-ins)
+    Renderer(TextureHandle atlas, TextureHandle map);
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+    ~Renderer();
+    // alpha: how far the display is between the last two simulation steps
+    void drawWorld(const World& world, float alpha = 1.f);
+    // the sorted sprites of view (world coordinates, at the camera) without
+    // drawing them: what drawWorld() submits
+    void buildDrawList(const World& world, float alpha, Rectangle view);
+    const DrawList& getDrawList() const { return drawList; }
+    void setLowResolution(bool enabled);
+    bool getLowResolution() const { return lowResolution; }
+private:
+    DrawList drawList;
+    bool lowResolution{false};
+    // created on first use, sized to the screen / PIXEL_SCALE
+    RenderTexture2D lowResTarget{};
+    // every character, weapon and prop sprite (see AtlasData.h)
+    TextureHandle atlasTexture;
+    TextureHandle mapTexture;
+    // culling results, reused every frame
+    std::vector<int> visibleEnemies;
+    std::vector<int> visibleProps;
+
+    void queueCharacter(const BaseCharacter& character, Rectangle idle, Rectangle run);
+    void queueMap(Vector2 knightPos, Rectangle view);
+    void queueEnemies(const EnemyPool& enemies, Vector2 cameraPos, float alpha);
+    void queueWeapon(const Character& knight);
+    void queueProp(const Prop& prop, Vector2 knightPos);
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include "Snapshot.h"
+#include <vector>
+
+// Weak reference to an entity. Stays safe to hold after the entity is gone:
+// its slot's generation moves on, so the handle simply stops resolving.
+struct EntityHandle
+{
+    unsigned int slot{~0u};
+    unsigned int generation{};
+
+    bool operator==(const EntityHandle& other) const
+    {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// Maps stable handles to the dense (swap-and-pop) indices of a pool such as
+// EnemyPool. Freed slots go on an intrusive free list and are recycled, so
+// once the slot array has grown to the peak entity count, create() and
+// destroy() are O(1) and never allocate.
+class SlotMap
+{
+public:
+    void reserve(int capacity) { slots.reserve(capacity); }
+
+    EntityHandle create(int denseIndex)
+    {
+        unsigned int slot;
+        if (freeHead != NO_SLOT)
+        {
+            slot = freeHead;
+            freeHead = slots[slot].nextFree;
+        }
+        else
+        {
+            slot = static_cast<unsigned int>(slots.size());
+            slots.emplace_back();
+        }
+        slots[slot].denseIndex = denseIndex;
+        slots[slot].nextFree = NO_SLOT;
+        return EntityHandle{slot, slots[slot].generation};
+    }
+
+    void destroy(EntityHandle handle)
+    {
+        if (find(handle) < 0)
+            return;
+        Slot& entry = slots[handle.slot];
+        // invalidates every outstanding handle to this slot
+        entry.generation++;
+        entry.denseIndex = -1;
+        entry.nextFree = freeHead;
+        freeHead = handle.slot;
+    }
+
+    // dense index of a live handle, -1 when it is stale or empty
+    int find(EntityHandle handle) const
+    {
+        if (handle.slot >= slots.size())
+            return -1;
+        const Slot& entry = slots[handle.slot];
+        return entry.generation == handle.generation ? entry.denseIndex : -1;
+    }
+
+    // the pool moved the entity (swap-and-pop)
+    void setDenseIndex(EntityHandle handle, int denseIndex) { slots[handle.slot].denseIndex = denseIndex; }
+
+    void saveState(SnapshotWriter& out) const
+    {
+        out.writeVector(slots);
+        out.write(freeHead);
+    }
+
+    void loadState(SnapshotReader& in)
+    {
+        in.readVector(slots);
+        in.read(freeHead);
+    }
+
+    // drop every entity, all handles handed out so far become stale
+    void clear()
+    {
+        freeHead = NO_SLOT;
+        for (unsigned int slot = 0; slot < slots.size(); slot++)
+        {
+            if (slots[slot].denseIndex >= 0)
+                slots[slot].generation++;
+            slots[slot].denseIndex = -1;
+            slots[slot].nextFree = freeHead;
+            freeHead = slot;
+        }
+    }
+private:
+    static const unsigned int NO_SLOT{~0u};
+    struct Slot
+    {
+        int denseIndex{-1};
+        unsigned int generation{};
+        unsigned int nextFree{NO_SLOT};
+    };
+
+    std::vector<Slot> slots;
+    unsigned int freeHead{NO_SLOT};
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// A flat byte copy of simulation state, see World::saveState().
+using Snapshot = std::vector<unsigned char>;
+
+// Appends plain values (memcpy) and vectors of them (length, then the
+// elements in one memcpy) to a snapshot.
+class SnapshotWriter
+{
+public:
+    explicit SnapshotWriter(Snapshot& out): bytes(out) { bytes.clear(); }
+
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshots hold plain values only");
+        std::size_t at = bytes.size();
+        bytes.resize(at + sizeof(T));
+        std::memcpy(bytes.data() + at, &value, sizeof(T));
+    }
+
+    template <typename T>
+    void writeVector(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshots hold plain values only");
+        write(values.size());
+        std::size_t at = bytes.size();
+        bytes.resize(at + values.size() * sizeof(T));
+        if (!values.empty())
+            std::memcpy(bytes.data() + at, values.data(), values.size() * sizeof(T));
+    }
+private:
+    Snapshot& bytes;
+};
+
+// Reads a snapshot back in the order it was written. Vectors are resized
+// but keep their capacity, so restoring the same snapshot again does not
+// allocate.
+class SnapshotReader
+{
+public:
+    explicit SnapshotReader(const Snapshot& in): bytes(in) {}
+
+    template <typename T>
+    void read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshots hold plain values only");
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+        offset += sizeof(T);
+    }
+
+    template <typename T>
+    void readVector(std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshots hold plain values only");
+        std::size_t count{};
+        read(count);
+        values.resize(count);
+        if (count > 0)
+            std::memcpy(values.data(), bytes.data() + offset, count * sizeof(T));
+        offset += count * sizeof(T);
+    }
+private:
+    const Snapshot& bytes;
+    std::size_t offset{};
+};
+
+#endif
@@ -0,0 +1,163 @@
+#include "SoundMixer.h"
+#include "Profiler.h"
+#include <cmath>
+
+// positional sounds play at full volume up to the near distance and fade
+// out linearly to silence at the far one
+const float ATTENUATION_NEAR{200.f};
+const float ATTENUATION_FAR{900.f};
+
+void SoundMixer::load(SoundId id, AssetCache& assets, const char* path, const SoundSettings& soundSettings)
+{
+    settings[id] = soundSettings;
+    if (settings[id].maxVoices > MAX_VOICES - voiceCount)
+        settings[id].maxVoices = MAX_VOICES - voiceCount;
+
+    // aliases share the sample data but play (and set volume) independently
+    firstVoice[id] = voiceCount;
+    for (int i = 0; i < settings[id].maxVoices; i++)
+    {
+        Voice& voice = voices[voiceCount++];
+        voice.sound = assets.getSoundAlias(path);
+        voice.id = id;
+        SetSoundPitch(*voice.sound, settings[id].pitch);
+    }
+}
+
+float SoundMixer::distanceSqr(Vector2 pos) const
+{
+    return (pos.x - listener.x) * (pos.x - listener.x) + (pos.y - listener.y) * (pos.y - listener.y);
+}
+
+void SoundMixer::push(SoundId id, Vector2 pos)
+{
+    // more would only take over the voices just started
+    if (queued[id] < settings[id].maxVoices)
+    {
+        events[eventCount++] = Event{id, pos};
+        queued[id]++;
+        return;
+    }
+    if (!settings[id].positional)
+        return;
+    // full: the new event replaces the furthest one if it is closer (to
+    // where the listener was last frame)
+    int furthest{-1};
+    for (int i = 0; i < eventCount; i++)
+        if (events[i].id == id && (furthest < 0 || distanceSqr(events[i].pos) > distanceSqr(events[furthest].pos)))
+            furthest = i;
+    if (furthest >= 0 && distanceSqr(pos) < distanceSqr(events[furthest].pos))
+        events[furthest].pos = pos;
+}
+
+void SoundMixer::stop(SoundId id)
+{
+    for (int i = firstVoice[id]; i < firstVoice[id] + settings[id].maxVoices; i++)
+    {
+        if (voices[i].playing)
+            StopSound(*voices[i].sound);
+        voices[i].playing = false;
+    }
+    int kept{};
+    for (int i = 0; i < eventCount; i++)
+        if (events[i].id != id)
+            events[kept++] = events[i];
+    eventCount = kept;
+    queued[id] = 0;
+}
+
+// A voice for sound id, or -1 to drop the event: a free voice of its own
+// if there is one, otherwise the oldest of its own. If that would make
+// too many voices play, the oldest voice of lower priority is stopped first.
+int SoundMixer::findVoice(int id)
+{
+    int playing{};
+    for (int i = 0; i < voiceCount; i++)
+        if (voices[i].playing)
+            playing++;
+
+    int own{-1};
+    for (int i = firstVoice[id]; i < firstVoice[id] + settings[id].maxVoices; i++)
+    {
+        if (!voices[i].playing)
+        {
+            own = i;
+            break;
+        }
+        if (own < 0 || voices[i].started < voices[own].started)
+            own = i;
+    }
+    if (own < 0)
+        return -1;
+    // taking over one of its own voices keeps the count
+    if (voices[own].playing || playing < MAX_PLAYING)
+        return own;
+
+    int victim{-1};
+    for (int i = 0; i < voiceCount; i++)
+    {
+        const Voice& voice = voices[i];
+        if (!voice.playing || settings[voice.id].priority >= settings[id].priority)
+            continue;
+        if (victim < 0 || settings[voice.id].priority < settings[voices[victim].id].priority ||
+            (settings[voice.id].priority == settings[voices[victim].id].priority && voice.started < voices[victim].started))
+            victim = i;
+    }
+    if (victim < 0)
+        return -1;
+    StopSound(*voices[victim].sound);
+    voices[victim].playing = false;
+    return own;
+}
+
+void SoundMixer::startVoice(int index, float volume)
+{
+    Voice& voice = voices[index];
+    SetSoundVolume(*voice.sound, volume);
+    PlaySound(*voice.sound);
+    voice.playing = true;
+    voice.started = ++startCount;
+}
+
+void SoundMixer::update(Vector2 listenerPos)
+{
+    PROFILE_ZONE("SoundMixer::update");
+    listener = listenerPos;
+    for (int i = 0; i < voiceCount; i++)
+        if (voices[i].playing)
+            voices[i].playing = IsSoundPlaying(*voices[i].sound);
+
+    for (int e = 0; e < eventCount; e++)
+    {
+        const Event& event = events[e];
+        const SoundSettings& sound = settings[event.id];
+        if (!sound.retrigger)
+        {
+            bool busy{false};
+            for (int i = firstVoice[event.id]; i < firstVoice[event.id] + sound.maxVoices; i++)
+                busy = busy || voices[i].playing;
+            if (busy)
+                continue;
+        }
+
+        float volume = sound.volume;
+        if (sound.positional)
+        {
+            float distance = std::sqrt(distanceSqr(event.pos));
+            if (distance >= ATTENUATION_FAR)
+                continue;
+            if (distance > ATTENUATION_NEAR)
+                volume *= (ATTENUATION_FAR - distance) / (ATTENUATION_FAR - ATTENUATION_NEAR);
+        }
+
+        int voice = findVoice(event.id);
+        if (voice < 0)
+            continue;
+        if (voices[voice].playing)
+            StopSound(*voices[voice].sound);
+        startVoice(voice, volume);
+    }
+    eventCount = 0;
+    for (int& count : queued)
+        count = 0;
+}
@@ -0,0 +1,86 @@
+#ifndef SOUND_MIXER_H
+#define SOUND_MIXER_H
+
+#include "raylib.h"
+#include "AssetCache.h"
+
+enum SoundId
+{
+    SOUND_STRIDE,
+    SOUND_ATTACK,
+    SOUND_ENEMY_KILLED,
+    SOUND_DEFEAT,
+    SOUND_ID_COUNT
+};
+
+struct SoundSettings
+{
+    float volume{1.f};
+    float pitch{1.f};
+    // voices of this sound that may play at once
+    int maxVoices{1};
+    // a full mixer stops a playing voice of lower priority for a new event
+    int priority{};
+    // false: events are ignored while the sound is still playing (sustained
+    // sounds like footsteps); true: every event starts a voice
+    bool retrigger{true};
+    // fade with the distance between the event and the listener
+    bool positional{false};
+};
+
+// Sound effects for the front end. Gameplay code only push()es events;
+// once per frame update() drains them into a fixed pool of voices (sound
+// aliases, a few per sound), so a hundred kills in one frame start at most
+// maxVoices voices of the kill sound, and never more than MAX_PLAYING in
+// total: a new event steals the oldest voice of lower priority, or of its
+// own sound when that sound is at its cap. Needs the audio device for its
+// whole lifetime.
+class SoundMixer
+{
+public:
+    static const int MAX_VOICES{16};
+    static const int MAX_PLAYING{6};
+
+    // make room for settings.maxVoices voices of the sound at path
+    void load(SoundId id, AssetCache& assets, const char* path, const SoundSettings& settings);
+    // queue a sound for this frame; pos (world coordinates) only matters
+    // for positional sounds. Past maxVoices events of a sound in one frame
+    // the closest ones are kept
+    void push(SoundId id, Vector2 pos = Vector2{});
+    // start this frame's events, listenerPos is where the ear is (the knight)
+    void update(Vector2 listenerPos);
+    // silence every voice of a sound and forget its queued events
+    void stop(SoundId id);
+private:
+    struct Voice
+    {
+        SoundHandle sound;
+        int id{};
+        bool playing{false};
+        // when it started, to find the oldest
+        unsigned long started{};
+    };
+    struct Event
+    {
+        int id{};
+        Vector2 pos{};
+    };
+
+    SoundSettings settings[SOUND_ID_COUNT]{};
+    // voices of sound id are [firstVoice[id], firstVoice[id] + settings[id].maxVoices)
+    int firstVoice[SOUND_ID_COUNT]{};
+    Voice voices[MAX_VOICES]{};
+    int voiceCount{};
+    // at most maxVoices per sound, so never more than the voices
+    Event events[MAX_VOICES]{};
+    int eventCount{};
+    int queued[SOUND_ID_COUNT]{};
+    Vector2 listener{};
+    unsigned long startCount{};
+
+    int findVoice(int id);
+    void startVoice(int voice, float volume);
+    float distanceSqr(Vector2 pos) const;
+};
+
+#endif
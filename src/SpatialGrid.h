@@ -0,0 +1,194 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "raylib.h"
+#include "Collision.h"
+#include "Snapshot.h"
+#include <vector>
+
+// Uniform grid over world coordinates for broadphase collision queries.
+// Each entry sits in the one cell holding its rect's top-left corner and is
+// moved between cells only when that corner crosses a cell edge; queries
+// widen the searched cells by the largest entry size so nothing is missed.
+// Positions outside the bounds are clamped into the border cells.
+template <typename T>
+class SpatialGrid
+{
+public:
+    SpatialGrid(Rectangle gridBounds, float gridCellSize):
+        bounds(gridBounds),
+        cellSize(gridCellSize),
+        columns(static_cast<int>(gridBounds.width / gridCellSize) + 1),
+        rows(static_cast<int>(gridBounds.height / gridCellSize) + 1),
+        cells(columns * rows)
+    {
+
+    }
+
+    // room for this many entries before insert() allocates again. The cells
+    // are not reserved: each keeps the capacity of its most crowded moment,
+    // so a cell allocates only when it holds more entries than ever before
+    void reserve(int capacity)
+    {
+        entries.reserve(capacity);
+        freeIds.reserve(capacity);
+    }
+
+    // returns the id used to move or remove the entry later
+    int insert(Rectangle rect, T item)
+    {
+        int id;
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        else
+        {
+            id = static_cast<int>(entries.size());
+            entries.emplace_back();
+        }
+        Entry& entry = entries[id];
+        entry.rect = rect;
+        entry.item = item;
+        grow(rect);
+        link(id, cellOf(rect));
+        return id;
+    }
+
+    void move(int id, Rectangle rect)
+    {
+        Entry& entry = entries[id];
+        entry.rect = rect;
+        grow(rect);
+        int cell = cellOf(rect);
+        if (cell != entry.cell)
+        {
+            unlink(id);
+            link(id, cell);
+        }
+    }
+
+    void remove(int id)
+    {
+        unlink(id);
+        freeIds.push_back(id);
+    }
+
+    void clear()
+    {
+        for (auto& cell : cells)
+            cell.clear();
+        entries.clear();
+        freeIds.clear();
+        maxWidth = 0.f;
+        maxHeight = 0.f;
+    }
+
+    void saveState(SnapshotWriter& out) const
+    {
+        for (const auto& cell : cells)
+            out.writeVector(cell);
+        out.writeVector(entries);
+        out.writeVector(freeIds);
+        out.write(maxWidth);
+        out.write(maxHeight);
+    }
+
+    // into a grid with the same bounds and cell size
+    void loadState(SnapshotReader& in)
+    {
+        for (auto& cell : cells)
+            in.readVector(cell);
+        in.readVector(entries);
+        in.readVector(freeIds);
+        in.read(maxWidth);
+        in.read(maxHeight);
+    }
+
+    // appends the item of every entry overlapping area to out
+    void query(Rectangle area, std::vector<T>& out) const
+    {
+        int minColumn, minRow, maxColumn, maxRow;
+        cellCoords(area.x - maxWidth, area.y - maxHeight, minColumn, minRow);
+        cellCoords(area.x + area.width, area.y + area.height, maxColumn, maxRow);
+
+        for (int row = minRow; row <= maxRow; row++)
+        {
+            for (int column = minColumn; column <= maxColumn; column++)
+            {
+                for (int id : cells[row * columns + column])
+                {
+                    const Entry& entry = entries[id];
+                    if (recsOverlap(entry.rect, area))
+                        out.push_back(entry.item);
+                }
+            }
+        }
+    }
+private:
+    struct Entry
+    {
+        Rectangle rect{};
+        T item{};
+        int cell{-1};
+        // position inside cells[cell]
+        int slot{-1};
+    };
+
+    Rectangle bounds{};
+    float cellSize{};
+    int columns{};
+    int rows{};
+    float maxWidth{};
+    float maxHeight{};
+    std::vector<std::vector<int>> cells;
+    std::vector<Entry> entries;
+    std::vector<int> freeIds;
+
+    void cellCoords(float x, float y, int& column, int& row) const
+    {
+        column = static_cast<int>((x - bounds.x) / cellSize);
+        row = static_cast<int>((y - bounds.y) / cellSize);
+        if (x < bounds.x) column = 0;
+        if (y < bounds.y) row = 0;
+        if (column >= columns) column = columns - 1;
+        if (row >= rows) row = rows - 1;
+    }
+
+    int cellOf(Rectangle rect) const
+    {
+        int column, row;
+        cellCoords(rect.x, rect.y, column, row);
+        return row * columns + column;
+    }
+
+    void grow(Rectangle rect)
+    {
+        if (rect.width > maxWidth) maxWidth = rect.width;
+        if (rect.height > maxHeight) maxHeight = rect.height;
+    }
+
+    void link(int id, int cell)
+    {
+        Entry& entry = entries[id];
+        entry.cell = cell;
+        entry.slot = static_cast<int>(cells[cell].size());
+        cells[cell].push_back(id);
+    }
+
+    // swap-and-pop out of the current cell
+    void unlink(int id)
+    {
+        Entry& entry = entries[id];
+        std::vector<int>& cell = cells[entry.cell];
+        int last = cell.back();
+        cell[entry.slot] = last;
+        entries[last].slot = entry.slot;
+        cell.pop_back();
+        entry.cell = -1;
+        entry.slot = -1;
+    }
+};
+
+#endif
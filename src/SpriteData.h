@@ -0,0 +1,27 @@
+#ifndef SPRITE_DATA_H
+#define SPRITE_DATA_H
+
+// Pixel sizes of the art in characters/ and nature_tileset/.
+// The simulation sizes its collision boxes from these so it never
+// has to load a texture (and can run without a window).
+
+// every character sheet is a single row of 6 frames, 16x16 each
+const float CHARACTER_FRAME_WIDTH{16.f};
+const float CHARACTER_FRAME_HEIGHT{16.f};
+const int CHARACTER_MAX_FRAMES{6};
+
+const float WEAPON_WIDTH{16.f};
+const float WEAPON_HEIGHT{16.f};
+
+const float ROCK_WIDTH{22.f};
+const float ROCK_HEIGHT{21.f};
+const float SIGN_WIDTH{22.f};
+const float SIGN_HEIGHT{25.f};
+const float LOG_WIDTH{27.f};
+const float LOG_HEIGHT{16.f};
+
+const float MAP_WIDTH{768.f};
+const float MAP_HEIGHT{768.f};
+const float MAP_SCALE{4.f};
+
+#endif
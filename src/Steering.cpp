@@ -0,0 +1,187 @@
+#include "Steering.h"
+#include <cmath>
+
+#if !defined(STEERING_FORCE_SCALAR)
+    #if defined(__AVX__)
+        #include <immintrin.h>
+        #define STEERING_AVX
+    #elif defined(__SSE2__) || defined(_M_X64)
+        #include <emmintrin.h>
+        #define STEERING_SSE2
+    #elif defined(__wasm_simd128__)
+        #include <wasm_simd128.h>
+        #define STEERING_WASM_SIMD
+    #endif
+#endif
+
+// keep a * b + c as two roundings, never a fused multiply-add
+#if defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#endif
+
+// share of the perpendicular added while circling
+const float CIRCLE_STRENGTH{0.3f};
+
+// Every path below does the same IEEE operations in the same order (no
+// fused multiply-add, sqrt and compares are exact), so results match bit
+// for bit whichever path runs.
+static void steerRange(const SteeringBatch& batch, int begin, int end, Vector2 targetScreenPos, Vector2 targetWorldPos)
+{
+    for (int i = begin; i < end; i++)
+    {
+        // get the velocity vector to the target (screen space, like the knight)
+        float vx = targetScreenPos.x - (batch.posX[i] - targetWorldPos.x);
+        float vy = targetScreenPos.y - (batch.posY[i] - targetWorldPos.y);
+        float distanceToTarget = std::sqrt(vx * vx + vy * vy);
+
+        if (distanceToTarget < batch.circleRadius && distanceToTarget > batch.radius)
+        {
+            // Add some circular movement
+            float px = -vy;
+            float py = vx;
+            vx = vx + px * CIRCLE_STRENGTH;
+            vy = vy + py * CIRCLE_STRENGTH;
+        }
+        else if (distanceToTarget < batch.stopRadius)
+        {
+            vx = 0.f;
+            vy = 0.f;
+        }
+
+        batch.velX[i] = vx;
+        batch.velY[i] = vy;
+    }
+}
+
+void steerTowardsScalar(const SteeringBatch& batch, Vector2 targetScreenPos, Vector2 targetWorldPos)
+{
+    steerRange(batch, 0, batch.count, targetScreenPos, targetWorldPos);
+}
+
+#if defined(STEERING_AVX)
+
+void steerTowards(const SteeringBatch& batch, Vector2 targetScreenPos, Vector2 targetWorldPos)
+{
+    const __m256 screenX = _mm256_set1_ps(targetScreenPos.x);
+    const __m256 screenY = _mm256_set1_ps(targetScreenPos.y);
+    const __m256 worldX = _mm256_set1_ps(targetWorldPos.x);
+    const __m256 worldY = _mm256_set1_ps(targetWorldPos.y);
+    const __m256 strength = _mm256_set1_ps(CIRCLE_STRENGTH);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 radius = _mm256_set1_ps(batch.radius);
+    const __m256 stopRadius = _mm256_set1_ps(batch.stopRadius);
+    const __m256 circleRadius = _mm256_set1_ps(batch.circleRadius);
+
+    int i = 0;
+    for (; i + 8 <= batch.count; i += 8)
+    {
+        __m256 vx = _mm256_sub_ps(screenX, _mm256_sub_ps(_mm256_loadu_ps(batch.posX + i), worldX));
+        __m256 vy = _mm256_sub_ps(screenY, _mm256_sub_ps(_mm256_loadu_ps(batch.posY + i), worldY));
+        __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+
+        __m256 circle = _mm256_and_ps(_mm256_cmp_ps(distance, circleRadius, _CMP_LT_OQ),
+                                      _mm256_cmp_ps(distance, radius, _CMP_GT_OQ));
+        __m256 stop = _mm256_andnot_ps(circle, _mm256_cmp_ps(distance, stopRadius, _CMP_LT_OQ));
+
+        __m256 circledX = _mm256_sub_ps(vx, _mm256_mul_ps(vy, strength));
+        __m256 circledY = _mm256_add_ps(vy, _mm256_mul_ps(vx, strength));
+        vx = _mm256_blendv_ps(vx, circledX, circle);
+        vy = _mm256_blendv_ps(vy, circledY, circle);
+        vx = _mm256_blendv_ps(vx, zero, stop);
+        vy = _mm256_blendv_ps(vy, zero, stop);
+
+        _mm256_storeu_ps(batch.velX + i, vx);
+        _mm256_storeu_ps(batch.velY + i, vy);
+    }
+    steerRange(batch, i, batch.count, targetScreenPos, targetWorldPos);
+}
+
+#elif defined(STEERING_SSE2)
+
+static inline __m128 select(__m128 mask, __m128 whenSet, __m128 whenClear)
+{
+    return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, whenClear));
+}
+
+void steerTowards(const SteeringBatch& batch, Vector2 targetScreenPos, Vector2 targetWorldPos)
+{
+    const __m128 screenX = _mm_set1_ps(targetScreenPos.x);
+    const __m128 screenY = _mm_set1_ps(targetScreenPos.y);
+    const __m128 worldX = _mm_set1_ps(targetWorldPos.x);
+    const __m128 worldY = _mm_set1_ps(targetWorldPos.y);
+    const __m128 strength = _mm_set1_ps(CIRCLE_STRENGTH);
+    const __m128 radius = _mm_set1_ps(batch.radius);
+    const __m128 stopRadius = _mm_set1_ps(batch.stopRadius);
+    const __m128 circleRadius = _mm_set1_ps(batch.circleRadius);
+
+    int i = 0;
+    for (; i + 4 <= batch.count; i += 4)
+    {
+        __m128 vx = _mm_sub_ps(screenX, _mm_sub_ps(_mm_loadu_ps(batch.posX + i), worldX));
+        __m128 vy = _mm_sub_ps(screenY, _mm_sub_ps(_mm_loadu_ps(batch.posY + i), worldY));
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+
+        __m128 circle = _mm_and_ps(_mm_cmplt_ps(distance, circleRadius),
+                                   _mm_cmpgt_ps(distance, radius));
+        __m128 stop = _mm_andnot_ps(circle, _mm_cmplt_ps(distance, stopRadius));
+
+        __m128 circledX = _mm_sub_ps(vx, _mm_mul_ps(vy, strength));
+        __m128 circledY = _mm_add_ps(vy, _mm_mul_ps(vx, strength));
+        vx = select(circle, circledX, vx);
+        vy = select(circle, circledY, vy);
+        // clearing the bits gives +0.f
+        vx = _mm_andnot_ps(stop, vx);
+        vy = _mm_andnot_ps(stop, vy);
+
+        _mm_storeu_ps(batch.velX + i, vx);
+        _mm_storeu_ps(batch.velY + i, vy);
+    }
+    steerRange(batch, i, batch.count, targetScreenPos, targetWorldPos);
+}
+
+#elif defined(STEERING_WASM_SIMD)
+
+void steerTowards(const SteeringBatch& batch, Vector2 targetScreenPos, Vector2 targetWorldPos)
+{
+    const v128_t screenX = wasm_f32x4_splat(targetScreenPos.x);
+    const v128_t screenY = wasm_f32x4_splat(targetScreenPos.y);
+    const v128_t worldX = wasm_f32x4_splat(targetWorldPos.x);
+    const v128_t worldY = wasm_f32x4_splat(targetWorldPos.y);
+    const v128_t strength = wasm_f32x4_splat(CIRCLE_STRENGTH);
+    const v128_t radius = wasm_f32x4_splat(batch.radius);
+    const v128_t stopRadius = wasm_f32x4_splat(batch.stopRadius);
+    const v128_t circleRadius = wasm_f32x4_splat(batch.circleRadius);
+
+    int i = 0;
+    for (; i + 4 <= batch.count; i += 4)
+    {
+        v128_t vx = wasm_f32x4_sub(screenX, wasm_f32x4_sub(wasm_v128_load(batch.posX + i), worldX));
+        v128_t vy = wasm_f32x4_sub(screenY, wasm_f32x4_sub(wasm_v128_load(batch.posY + i), worldY));
+        v128_t distance = wasm_f32x4_sqrt(wasm_f32x4_add(wasm_f32x4_mul(vx, vx), wasm_f32x4_mul(vy, vy)));
+
+        v128_t circle = wasm_v128_and(wasm_f32x4_lt(distance, circleRadius),
+                                      wasm_f32x4_gt(distance, radius));
+        v128_t stop = wasm_v128_andnot(wasm_f32x4_lt(distance, stopRadius), circle);
+
+        v128_t circledX = wasm_f32x4_sub(vx, wasm_f32x4_mul(vy, strength));
+        v128_t circledY = wasm_f32x4_add(vy, wasm_f32x4_mul(vx, strength));
+        vx = wasm_v128_bitselect(circledX, vx, circle);
+        vy = wasm_v128_bitselect(circledY, vy, circle);
+        // clearing the bits gives +0.f
+        vx = wasm_v128_andnot(vx, stop);
+        vy = wasm_v128_andnot(vy, stop);
+
+        wasm_v128_store(batch.velX + i, vx);
+        wasm_v128_store(batch.velY + i, vy);
+    }
+    steerRange(batch, i, batch.count, targetScreenPos, targetWorldPos);
+}
+
+#else
+
+void steerTowards(const SteeringBatch& batch, Vector2 targetScreenPos, Vector2 targetWorldPos)
+{
+    steerRange(batch, 0, batch.count, targetScreenPos, targetWorldPos);
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef STEERING_H
+#define STEERING_H
+
+#include "raylib.h"
+
+// Inputs and outputs of one steering pass over N enemies of one archetype
+// (a range of the EnemyPool arrays)
+struct SteeringBatch
+{
+    const float* posX{};
+    const float* posY{};
+    // stop when closer than stopRadius; circle the target while between
+    // radius and circleRadius (0 for archetypes that never circle)
+    float radius{};
+    float stopRadius{};
+    float circleRadius{};
+    float* velX{};
+    float* velY{};
+    int count{};
+};
+
+// Pursuit of the knight for every enemy in the batch: velocity toward the
+// target, zeroed inside the stop radius, with a perpendicular offset added
+// inside the circling band. Uses AVX or SSE2 on desktop and SIMD128 in the
+// emscripten build (-msimd128); the scalar path gives bit-identical results
+// and is used for the remainder and when STEERING_FORCE_SCALAR is defined.
+void steerTowards(const SteeringBatch& batch, Vector2 targetScreenPos, Vector2 targetWorldPos);
+// the scalar path alone, the reference the bench checks steerTowards against
+void steerTowardsScalar(const SteeringBatch& batch, Vector2 targetScreenPos, Vector2 targetWorldPos);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+// The simulation advances in fixed steps, whatever the display rate;
+// the renderer interpolates between the last two steps.
+const float SIMULATION_RATE{120.f};
+const float FIXED_TIME_STEP{1.f / SIMULATION_RATE};
+// longest frame the front end catches up on, a longer stall (tab in the
+// background, a breakpoint) just slows the game down instead
+const float MAX_FRAME_TIME{0.25f};
+
+// speeds are in pixels per frame at the 60 FPS the game was tuned at
+const float SPEED_REFERENCE_RATE{60.f};
+
+#endif
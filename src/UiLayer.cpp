@@ -0,0 +1,30 @@
+#include "UiLayer.h"
+
+UiLayer::UiLayer(int layerWidth, int layerHeight):
+    target(LoadRenderTexture(layerWidth, layerHeight))
+{
+
+}
+
+UiLayer::~UiLayer()
+{
+    UnloadRenderTexture(target);
+}
+
+void UiLayer::begin()
+{
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+}
+
+void UiLayer::end()
+{
+    EndTextureMode();
+}
+
+void UiLayer::draw(Vector2 pos) const
+{
+    // render textures are stored upside down
+    Rectangle source{0.f, 0.f, static_cast<float>(target.texture.width), -static_cast<float>(target.texture.height)};
+    DrawTextureRec(target.texture, source, pos, WHITE);
+}
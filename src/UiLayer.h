@@ -0,0 +1,27 @@
+#ifndef UI_LAYER_H
+#define UI_LAYER_H
+
+#include "raylib.h"
+
+// A piece of UI drawn once into its own render texture and blitted every
+// frame after, so unchanged text builds no glyph quads. Redraw it between
+// begin() and end() only when what it shows changes. Needs an open window
+// for its whole lifetime.
+class UiLayer
+{
+public:
+    UiLayer(int layerWidth, int layerHeight);
+    UiLayer(const UiLayer&) = delete;
+    UiLayer& operator=(const UiLayer&) = delete;
+    ~UiLayer();
+    // draw calls in between land in the layer (cleared to transparent),
+    // in layer coordinates
+    void begin();
+    void end();
+    // blit with the layer's top-left at pos
+    void draw(Vector2 pos) const;
+private:
+    RenderTexture2D target{};
+};
+
+#endif
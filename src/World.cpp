@@ -0,0 +1,267 @@
+#include "World.h"
+#include "SpriteData.h"
+#include "Profiler.h"
+#include "raymath.h"
+#include <algorithm>
+
+// enemies the pool and its grid hold before spawning has to allocate
+// (a grid cell still grows the first time it gets more crowded than ever)
+const int ENEMY_CAPACITY{1024};
+// flow field cells, and how many of them are integrated per step (a full
+// rebuild of the 89x89 field takes about eight steps)
+const float FLOW_CELL_SIZE{64.f};
+const int FLOW_CELL_BUDGET{1024};
+// props grow by half an enemy (16 px frames at scale 4) on every side:
+// the field routes enemy centres
+const float FLOW_OBSTACLE_MARGIN{CHARACTER_FRAME_WIDTH * 4.f * 0.5f};
+
+World::World(int viewWidth, int viewHeight, unsigned int seed):
+    windowWidth(viewWidth),
+    windowHeight(viewHeight),
+    knight(viewWidth, viewHeight),
+    knightPrevPos(knight.getWorldPos()),
+    enemyGrid(GRID_BOUNDS, GRID_CELL_SIZE),
+    propGrid(GRID_BOUNDS, GRID_CELL_SIZE),
+    flowField(GRID_BOUNDS, FLOW_CELL_SIZE),
+    gen(seed)
+{
+    props = {
+        Prop{Vector2{800.f, 1200.f}, Prop::ROCK, 7.f},
+        Prop{Vector2{1450.f, 950.f}, Prop::SIGN, 4.f},
+        Prop{Vector2{1800.f, 1650.f}, Prop::ROCK, 10.f},
+        Prop{Vector2{600.f, 700.f}, Prop::LOG, 6.f},
+        Prop{Vector2{1500.f, 300.f}, Prop::LOG, 5.f},
+        Prop{Vector2{2100.f, 500.f}, Prop::ROCK, 6.5f}};
+    for (int i = 0; i < static_cast<int>(props.size()); i++)
+        propGrid.insert(props[i].getWorldCollisionRec(), i);
+
+    for (const auto& prop : props)
+    {
+        Rectangle rect = prop.getWorldCollisionRec();
+        flowField.addObstacle(Rectangle{rect.x - FLOW_OBSTACLE_MARGIN, rect.y - FLOW_OBSTACLE_MARGIN,
+                                        rect.width + 2.f * FLOW_OBSTACLE_MARGIN, rect.height + 2.f * FLOW_OBSTACLE_MARGIN});
+    }
+
+    enemies.reserve(ENEMY_CAPACITY);
+    enemyGrid.reserve(ENEMY_CAPACITY);
+
+    // Initial enemies
+    addEnemy(Vector2{1250.f, 350.f}, 3.f, EnemyPool::GOBLIN);
+    addEnemy(Vector2{2700.f, 2500.f}, 3.9f, EnemyPool::GOBLIN);
+    addEnemy(Vector2{3200.f, 250.f}, 2.8f, EnemyPool::GOBLIN);
+    addEnemy(Vector2{3600.f, 2900.f}, 3.2f, EnemyPool::GOBLIN);
+    addEnemy(Vector2{1800.f, 600.f}, 2.5f, EnemyPool::GOBLIN);
+    addEnemy(Vector2{2200.f, 1200.f}, 4.5f, EnemyPool::GOBLIN);
+
+    addEnemy(Vector2{1900.f, 3000.f}, 1.7f, EnemyPool::SLIME);
+    addEnemy(Vector2{1330.f, 2330.f}, 2.9f, EnemyPool::SLIME);
+    addEnemy(Vector2{500.f, 800.f}, 1.2f, EnemyPool::SLIME);
+    addEnemy(Vector2{3000.f, 3500.f}, 3.8f, EnemyPool::SLIME);
+    addEnemy(Vector2{900.f, 2800.f}, 1.5f, EnemyPool::SLIME);
+    addEnemy(Vector2{2500.f, 1800.f}, 2.1f, EnemyPool::SLIME);
+    addEnemy(Vector2{1600.f, 1000.f}, 1.9f, EnemyPool::SLIME);
+
+    addEnemy(Vector2{2670.f, 2900.f}, 2.2f, EnemyPool::INTELLECT_DEVOURER);
+    addEnemy(Vector2{4000.f, 1500.f}, 4.1f, EnemyPool::INTELLECT_DEVOURER);
+    addEnemy(Vector2{700.f, 1800.f}, 1.8f, EnemyPool::INTELLECT_DEVOURER);
+    addEnemy(Vector2{3800.f, 3200.f}, 3.5f, EnemyPool::INTELLECT_DEVOURER);
+
+    addEnemy(Vector2{4200.f, 800.f}, 5.2f, EnemyPool::ELITE_GOBLIN);
+    addEnemy(Vector2{200.f, 3800.f}, 4.8f, EnemyPool::ELITE_GOBLIN);
+
+    addEnemy(Vector2{4500.f, 2000.f}, 2.5f, EnemyPool::SLIME_KING);
+    addEnemy(Vector2{300.f, 2200.f}, 2.8f, EnemyPool::SLIME_KING);
+}
+
+EntityHandle World::addEnemy(Vector2 pos, float speed, EnemyPool::EnemyType type)
+{
+    int index = enemies.add(pos, speed, type);
+    enemies.setGridId(index, enemyGrid.insert(enemies.getWorldCollisionRec(index), enemies.getHandle(index)));
+    return enemies.getHandle(index);
+}
+
+void World::removeEnemy(int index)
+{
+    enemyGrid.remove(enemies.getGridId(index));
+    enemies.remove(index);
+}
+
+void World::clearEnemies()
+{
+    enemies.clear();
+    enemyGrid.clear();
+}
+
+void World::undoEnemyMovement(int index)
+{
+    enemies.undoMovement(index);
+    enemyGrid.move(enemies.getGridId(index), enemies.getWorldCollisionRec(index));
+}
+
+Vector2 World::getCameraPos(float alpha) const
+{
+    return Vector2Lerp(knightPrevPos, knight.getWorldPos(), alpha);
+}
+
+void World::queryEnemies(Rectangle area, std::vector<int>& out) const
+{
+    nearbyEnemies.clear();
+    enemyGrid.query(area, nearbyEnemies);
+    out.clear();
+    for (EntityHandle enemy : nearbyEnemies)
+        out.push_back(enemies.find(enemy));
+    std::sort(out.begin(), out.end());
+}
+
+void World::queryProps(Rectangle area, std::vector<int>& out) const
+{
+    out.clear();
+    propGrid.query(area, out);
+    std::sort(out.begin(), out.end());
+}
+
+void World::saveState(Snapshot& out) const
+{
+    SnapshotWriter writer(out);
+    knight.saveState(writer);
+    writer.write(knightPrevPos);
+    // the props are the ones every World is built with, only their state varies
+    for (const auto& prop : props)
+        writer.write(prop);
+    enemies.saveState(writer);
+    writer.write(events);
+    enemyGrid.saveState(writer);
+    propGrid.saveState(writer);
+    flowField.saveState(writer);
+    writer.write(gen);
+    writer.write(enemySpawnTimer);
+}
+
+void World::loadState(const Snapshot& in)
+{
+    PROFILE_ZONE("World::loadState");
+    SnapshotReader reader(in);
+    knight.loadState(reader);
+    reader.read(knightPrevPos);
+    for (auto& prop : props)
+        reader.read(prop);
+    enemies.loadState(reader);
+    reader.read(events);
+    enemyGrid.loadState(reader);
+    propGrid.loadState(reader);
+    flowField.loadState(reader);
+    reader.read(gen);
+    reader.read(enemySpawnTimer);
+}
+
+void World::spawnRandomEnemy()
+{
+    PROFILE_ZONE("World::spawnRandomEnemy");
+    EnemyPool::EnemyType type = static_cast<EnemyPool::EnemyType>(enemyTypeDist(gen));
+    Vector2 spawnPos = {static_cast<float>(posXDist(gen)), static_cast<float>(posYDist(gen))};
+    float speed = speedDist(gen);
+    addEnemy(spawnPos, speed, type);
+}
+
+void World::step(float deltaTime, const WorldInput& input)
+{
+    PROFILE_ZONE("World::step");
+    events = WorldEvents{};
+
+    // positions to interpolate from (also on the frozen end screens)
+    knightPrevPos = knight.getWorldPos();
+    enemies.savePositions();
+
+    // the game is frozen on the end screens
+    if (isGameOver() || isVictory())
+        return;
+
+    // Update enemy spawn timer
+    enemySpawnTimer += deltaTime;
+    if (enemySpawnTimer >= ENEMY_SPAWN_INTERVAL) {
+        spawnRandomEnemy();
+        enemySpawnTimer = 0.0f;
+    }
+
+    knight.setInput(input.held);
+    knight.tick(deltaTime);
+
+    // check map bounds
+    if (knight.getWorldPos().x < -130.f ||
+        knight.getWorldPos().y < -100.f ||
+        (knight.getWorldPos().x + windowHeight) * 0.99f > MAP_WIDTH * MAP_SCALE ||
+        (knight.getWorldPos().y + windowHeight) * 0.99f > MAP_HEIGHT * MAP_SCALE)
+    {
+        knight.undoMovement();
+    }
+
+    resolvePropCollisions();
+    float contactDamage = tickEnemies(deltaTime);
+    if (contactDamage > 0.f)
+        knight.takeDamage(contactDamage);
+    updateEnemyGrid();
+
+    if (input.pressed & INPUT_ATTACK)
+        sweepWeapon();
+
+    events.knightDied = !knight.getAlive();
+}
+
+void World::resolvePropCollisions()
+{
+    PROFILE_ZONE("World::propCollisions");
+    nearbyProps.clear();
+    propGrid.query(knight.getWorldCollisionRec(), nearbyProps);
+    if (!nearbyProps.empty())
+        knight.undoMovement();
+
+    for (const auto& prop : props)
+    {
+        nearbyEnemies.clear();
+        enemyGrid.query(prop.getWorldCollisionRec(), nearbyEnemies);
+        for (EntityHandle enemy : nearbyEnemies)
+            undoEnemyMovement(enemies.find(enemy));
+    }
+}
+
+float World::tickEnemies(float deltaTime)
+{
+    {
+        PROFILE_ZONE("World::flowField");
+        Rectangle knightRec = knight.getWorldCollisionRec();
+        flowField.update(Vector2{knightRec.x + knightRec.width * 0.5f, knightRec.y + knightRec.height * 0.5f},
+                         FLOW_CELL_BUDGET);
+    }
+
+    // they also push themselves back out of the knight
+    return enemies.tick(deltaTime, knight.getScreenPos(), knight.getWorldPos(),
+                        knight.getWorldCollisionRec(), &flowField, jobSystem);
+}
+
+void World::updateEnemyGrid()
+{
+    PROFILE_ZONE("World::updateGrid");
+    // the other sleepers have not moved
+    for (int type = 0; type < EnemyPool::ENEMY_TYPE_COUNT; type++)
+        for (int i = enemies.getGroupBegin(type); i < enemies.getMovedEnd(type); i++)
+            enemyGrid.move(enemies.getGridId(i), enemies.getWorldCollisionRec(i));
+}
+
+void World::sweepWeapon()
+{
+    PROFILE_ZONE("World::weaponSweep");
+    nearbyEnemies.clear();
+    enemyGrid.query(knight.getWorldWeaponCollisionRec(), nearbyEnemies);
+    // removal moves other enemies, look each one up again
+    for (EntityHandle enemy : nearbyEnemies)
+    {
+        int index = enemies.find(enemy);
+        if (events.enemiesKilled < WorldEvents::MAX_KILL_POSITIONS)
+        {
+            Rectangle rec = enemies.getWorldCollisionRec(index);
+            events.killPositions[events.enemiesKilled] = Vector2{rec.x + rec.width * 0.5f, rec.y + rec.height * 0.5f};
+        }
+        removeEnemy(index);
+        events.enemiesKilled++;
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "raylib.h"
+#include "Input.h"
+#include "Character.h"
+#include "EnemyPool.h"
+#include "FlowField.h"
+#include "Prop.h"
+#include "SpatialGrid.h"
+#include "Snapshot.h"
+#include <vector>
+#include <random>
+
+class JobSystem;
+
+// Area covered by the broadphase grids (the map plus the spawn margin);
+// anything further out lands in the border cells
+const Rectangle GRID_BOUNDS{-512.f, -512.f, 5632.f, 5632.f};
+const float GRID_CELL_SIZE{128.f};
+
+// What happened during the last step, for the front end (sounds etc.)
+struct WorldEvents
+{
+    static const int MAX_KILL_POSITIONS{16};
+    int enemiesKilled{};
+    // world centres of the first MAX_KILL_POSITIONS enemies killed
+    Vector2 killPositions[MAX_KILL_POSITIONS]{};
+    bool knightDied{false};
+};
+
+// The whole game simulation: knight, enemies, props and the spawner.
+// It never draws, plays audio or reads a device, so it runs without a
+// window and as fast as the CPU allows (see headless_main.cpp).
+class World
+{
+public:
+    World(int viewWidth, int viewHeight, unsigned int seed);
+    void step(float deltaTime, const WorldInput& input);
+
+    // The parts of step() that scale with the enemy count, in the order it
+    // runs them; public so the benchmarks time exactly this code.
+    // knight and enemies that walked into a prop go back where they were
+    void resolvePropCollisions();
+    // flow field and enemy update, returns the contact damage to the knight
+    float tickEnemies(float deltaTime);
+    // the grid entries of the enemies tickEnemies() moved
+    void updateEnemyGrid();
+    // kill every enemy the knight's weapon touches
+    void sweepWeapon();
+
+    // enemies besides the spawner's
+    EntityHandle addEnemy(Vector2 pos, float speed, EnemyPool::EnemyType type);
+    void removeEnemy(int index);
+    void clearEnemies();
+
+    // spread the enemy update over a job system's threads (nullptr: serial).
+    // The World does not own it, so one pool can serve many Worlds
+    void setJobSystem(JobSystem* jobs) { jobSystem = jobs; }
+    // Everything a step can change (knight, enemies, grids, flow field,
+    // spawner timer and generator, props) as one flat buffer; loading it
+    // puts this World back exactly where it was, allocating nothing once
+    // the World has held that many enemies, and that many in each grid
+    // cell. Only load snapshots saved by a World of the same view size.
+    void saveState(Snapshot& out) const;
+    void loadState(const Snapshot& in);
+    // restart the spawner's random sequence
+    void reseed(unsigned int seed) { gen.seed(seed); }
+
+    const Character& getKnight() const { return knight; }
+    // the camera (the knight's worldPos) between the last two steps,
+    // alpha 0 (previous step) to 1 (current)
+    Vector2 getCameraPos(float alpha) const;
+    const EnemyPool& getEnemies() const { return enemies; }
+    const std::vector<Prop>& getProps() const { return props; }
+    const WorldEvents& getEvents() const { return events; }
+    bool isGameOver() const { return !knight.getAlive(); }
+    bool isVictory() const { return enemies.empty(); }
+    // indices of the enemies/props whose world collision rect touches area,
+    // in ascending order (the rects are also the sprites' draw rects)
+    void queryEnemies(Rectangle area, std::vector<int>& out) const;
+    void queryProps(Rectangle area, std::vector<int>& out) const;
+private:
+    int windowWidth{};
+    int windowHeight{};
+    Character knight;
+    Vector2 knightPrevPos{};
+    std::vector<Prop> props;
+    EnemyPool enemies;
+    WorldEvents events{};
+    JobSystem* jobSystem{nullptr};
+
+    // broadphase: collision cost follows local density, not props x enemies
+    // enemy indices move when the pool regroups, so the grid holds handles
+    SpatialGrid<EntityHandle> enemyGrid;
+    SpatialGrid<int> propGrid;
+    // routes around the props toward the knight, shared by every enemy
+    FlowField flowField;
+    // query results, reused every step
+    mutable std::vector<EntityHandle> nearbyEnemies;
+    std::vector<int> nearbyProps;
+
+    // Random number generator for spawning
+    std::mt19937 gen;
+    std::uniform_int_distribution<> enemyTypeDist{0, EnemyPool::ENEMY_TYPE_COUNT - 1};
+    std::uniform_real_distribution<> posXDist{1200.f, 3300.f}; // Bigger center area of map
+    std::uniform_real_distribution<> posYDist{1000.f, 3000.f}; // Bigger center area of map
+    std::uniform_real_distribution<> speedDist{1.5f, 5.0f};
+
+    // Enemy spawning timer
+    float enemySpawnTimer{};
+    const float ENEMY_SPAWN_INTERVAL{7.5f};
+
+    void spawnRandomEnemy();
+    void undoEnemyMovement(int index);
+};
+
+#endif
@@ -0,0 +1,317 @@
+#include "World.h"
+#include "Renderer.h"
+#include "Steering.h"
+#include "JobSystem.h"
+#include "SpriteData.h"
+#include "Timing.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Microbenchmarks of the per-step hot loops at growing enemy counts, to
+// hold optimizations to numbers and catch scaling cliffs early. Everything
+// but the steering kernel is timed through World and Renderer themselves.
+//   usage: Arachisya_bench [filter] [seconds]
+// filter runs only the benchmarks whose name contains it; seconds is the
+// minimum measured time per case (default 0.2). Prints CSV on stdout, one
+// line per case: ms_per_frame is the mean time of one pass over every
+// entity (one frame's worth of work), ns_per_entity that divided by the
+// entity count, min_ms the fastest pass. Before timing anything it checks
+// the SIMD steering against the scalar reference (steering_check) and
+// exits with status 1 if they differ.
+
+// steerTowards against steerTowardsScalar: random batches, with counts
+// that leave every remainder length after the vector loop
+const int STEERING_CHECK_BATCHES{200};
+const int STEERING_CHECK_MAX_COUNT{67};
+// the desktop window
+const int VIEW_WIDTH{682};
+const int VIEW_HEIGHT{576};
+const int ENTITY_COUNTS[]{100, 1000, 10000, 100000};
+const int MIN_ITERATIONS{5};
+const unsigned int BENCH_SEED{1u};
+// steps run after spawning, so far enemies are asleep and the mid-range
+// ones spread over their update slots before the state is saved
+const int SETTLE_STEPS{32};
+
+// A World whose enemies are spread at random over a map-sized square around
+// the knight, so the density is that of N enemies on the map and the AI
+// levels of detail (near, mid-range, asleep) mix as they do in a game.
+struct Scene
+{
+    std::unique_ptr<World> world;
+    // the state after setup, restored before every pass that changes it
+    Snapshot initial;
+
+    void populate(int count)
+    {
+        world.reset(new World(VIEW_WIDTH, VIEW_HEIGHT, BENCH_SEED));
+        // one step (with the spawner's enemies still there) places the
+        // knight's weapon
+        world->step(FIXED_TIME_STEP, WorldInput{});
+        world->clearEnemies();
+
+        std::mt19937 gen(BENCH_SEED);
+        Rectangle knightRec = world->getKnight().getWorldCollisionRec();
+        Vector2 center{knightRec.x + knightRec.width * 0.5f, knightRec.y + knightRec.height * 0.5f};
+        float half = MAP_WIDTH * MAP_SCALE * 0.5f;
+        std::uniform_real_distribution<float> offset(-half, half);
+        std::uniform_int_distribution<> typeDist(0, EnemyPool::ENEMY_TYPE_COUNT - 1);
+        std::uniform_real_distribution<float> speedDist(1.5f, 5.f);
+        for (int i = 0; i < count; i++)
+        {
+            Vector2 pos{center.x + offset(gen), center.y + offset(gen)};
+            world->addEnemy(pos, speedDist(gen), static_cast<EnemyPool::EnemyType>(typeDist(gen)));
+        }
+        // the enemy phases only: the knight neither moves nor takes damage
+        for (int i = 0; i < SETTLE_STEPS; i++)
+        {
+            world->resolvePropCollisions();
+            world->tickEnemies(FIXED_TIME_STEP);
+            world->updateEnemyGrid();
+        }
+        world->saveState(initial);
+    }
+
+    void restore() { world->loadState(initial); }
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Runs pass(scene) until it has been measured for minSeconds (and at least
+// MIN_ITERATIONS times) and prints the result. pass returns the seconds it
+// wants counted, so it can leave resetting the scene out.
+template <typename Pass>
+static void measure(const char* name, int entities, double minSeconds, Scene& scene, Pass pass)
+{
+    pass(scene); // warm up caches and vector capacities
+    double total{};
+    double fastest{1e30};
+    long iterations{};
+    while (total < minSeconds || iterations < MIN_ITERATIONS)
+    {
+        double seconds = pass(scene);
+        total += seconds;
+        if (seconds < fastest)
+            fastest = seconds;
+        iterations++;
+    }
+    double ms = total * 1000.0 / iterations;
+    std::printf("%s,%d,%ld,%.6f,%.3f,%.6f\n", name, entities, iterations, ms,
+                ms * 1e6 / entities, fastest * 1000.0);
+    std::fflush(stdout);
+}
+
+// the steering kernel alone, over N enemies of one archetype
+static double steeringPass(const Scene& scene, std::vector<float>& buffers)
+{
+    int count = static_cast<int>(buffers.size() / 4);
+    SteeringBatch batch{};
+    batch.posX = buffers.data();
+    batch.posY = buffers.data() + count;
+    batch.velX = buffers.data() + 2 * count;
+    batch.velY = buffers.data() + 3 * count;
+    batch.radius = 25.f;
+    batch.stopRadius = 25.f;
+    batch.circleRadius = 120.f;
+    batch.count = count;
+    const Character& knight = scene.world->getKnight();
+    auto start = Clock::now();
+    steerTowards(batch, knight.getScreenPos(), knight.getWorldPos());
+    return secondsSince(start);
+}
+
+// Whether the SIMD path matches the scalar reference bit for bit, on
+// positions spread over every band of the pursuit (stopped, circling,
+// chasing). Prints the first mismatch.
+static bool checkSteering()
+{
+    std::mt19937 gen(BENCH_SEED);
+    std::uniform_int_distribution<> countDist(0, STEERING_CHECK_MAX_COUNT);
+    std::uniform_real_distribution<float> targetDist(0.f, MAP_WIDTH * MAP_SCALE);
+    std::uniform_real_distribution<float> offsetDist(-200.f, 200.f);
+    std::uniform_real_distribution<float> radiusDist(0.f, 60.f);
+    std::vector<float> posX, posY, velX, velY, refX, refY;
+    for (int b = 0; b < STEERING_CHECK_BATCHES; b++)
+    {
+        int count = countDist(gen);
+        Vector2 screenPos{targetDist(gen), targetDist(gen)};
+        Vector2 worldPos{targetDist(gen), targetDist(gen)};
+        // where an enemy sits right on the target
+        Vector2 center{screenPos.x + worldPos.x, screenPos.y + worldPos.y};
+        posX.resize(count);
+        posY.resize(count);
+        for (int i = 0; i < count; i++)
+        {
+            posX[i] = center.x + offsetDist(gen);
+            posY[i] = center.y + offsetDist(gen);
+        }
+        velX.assign(count, 0.f);
+        velY.assign(count, 0.f);
+        refX.assign(count, 0.f);
+        refY.assign(count, 0.f);
+
+        SteeringBatch batch{};
+        batch.posX = posX.data();
+        batch.posY = posY.data();
+        batch.radius = radiusDist(gen);
+        batch.stopRadius = radiusDist(gen);
+        // every other batch never circles, like the slimes
+        batch.circleRadius = b % 2 ? 0.f : batch.radius + 3.f * radiusDist(gen);
+        batch.count = count;
+        batch.velX = velX.data();
+        batch.velY = velY.data();
+        steerTowards(batch, screenPos, worldPos);
+        batch.velX = refX.data();
+        batch.velY = refY.data();
+        steerTowardsScalar(batch, screenPos, worldPos);
+
+        for (int i = 0; i < count; i++)
+        {
+            if (std::memcmp(&velX[i], &refX[i], sizeof(float)) != 0 ||
+                std::memcmp(&velY[i], &refY[i], sizeof(float)) != 0)
+            {
+                std::fprintf(stderr, "steering mismatch: batch %d enemy %d of %d: (%a, %a) scalar (%a, %a)\n",
+                             b, i, count, velX[i], velY[i], refX[i], refY[i]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// one step's enemy update, the same step every pass
+static double enemyTickPass(Scene& scene)
+{
+    scene.restore();
+    auto start = Clock::now();
+    scene.world->tickEnemies(FIXED_TIME_STEP);
+    return secondsSince(start);
+}
+
+// the props against the knight and the enemies the update just moved,
+// then those enemies back into the grid
+static double collisionPass(Scene& scene)
+{
+    scene.restore();
+    scene.world->tickEnemies(FIXED_TIME_STEP);
+    auto start = Clock::now();
+    scene.world->resolvePropCollisions();
+    scene.world->updateEnemyGrid();
+    return secondsSince(start);
+}
+
+// one sword swing
+static double weaponSweepPass(Scene& scene)
+{
+    scene.restore();
+    auto start = Clock::now();
+    scene.world->sweepWeapon();
+    return secondsSince(start);
+}
+
+// N enemies added to the World, then removed in the order they came
+static double spawnDespawnPass(Scene& scene, int count, std::vector<EntityHandle>& spawned)
+{
+    World& world = *scene.world;
+    world.clearEnemies();
+    spawned.clear();
+    Rectangle knightRec = world.getKnight().getWorldCollisionRec();
+    auto start = Clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        Vector2 pos{knightRec.x + static_cast<float>((i * 37) % 3072) - 1536.f,
+                    knightRec.y + static_cast<float>((i * 53) % 3072) - 1536.f};
+        spawned.push_back(world.addEnemy(pos, 3.f, static_cast<EnemyPool::EnemyType>(i % EnemyPool::ENEMY_TYPE_COUNT)));
+    }
+    for (EntityHandle enemy : spawned)
+        world.removeEnemy(world.getEnemies().find(enemy));
+    return secondsSince(start);
+}
+
+// one frame's sprites, culled to the screen and sorted as the Renderer
+// does every frame (submitting them needs a GPU and is left out)
+static double drawListPass(const Scene& scene, Renderer& renderer)
+{
+    const World& world = *scene.world;
+    Vector2 cameraPos = world.getCameraPos(0.5f);
+    Rectangle view{cameraPos.x, cameraPos.y, static_cast<float>(VIEW_WIDTH), static_cast<float>(VIEW_HEIGHT)};
+    auto start = Clock::now();
+    renderer.buildDrawList(world, 0.5f, view);
+    return secondsSince(start);
+}
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : "";
+    double minSeconds = argc > 2 ? std::atof(argv[2]) : 0.2;
+    auto wanted = [filter](const char* name) { return std::strstr(name, filter) != nullptr; };
+
+    Scene scene;
+    JobSystem jobs;
+    // never uploaded: the draw list only keeps the ids, and the map's size
+    // bounds the part of it that is queued
+    Texture2D atlas{};
+    atlas.id = 1;
+    Texture2D map{};
+    map.id = 2;
+    map.width = static_cast<int>(MAP_WIDTH);
+    map.height = static_cast<int>(MAP_HEIGHT);
+    Renderer renderer(std::make_shared<Texture2D>(atlas), std::make_shared<Texture2D>(map));
+    std::vector<float> steeringBuffers;
+    std::vector<EntityHandle> spawned;
+
+    // timing a kernel that is wrong would be pointless
+    if (wanted("steering_check") && !checkSteering())
+        return 1;
+
+    std::printf("benchmark,entities,iterations,ms_per_frame,ns_per_entity,min_ms\n");
+    for (int count : ENTITY_COUNTS)
+    {
+        scene.populate(count);
+
+        if (wanted("steering"))
+        {
+            std::mt19937 gen(BENCH_SEED);
+            std::uniform_real_distribution<float> pos(0.f, MAP_WIDTH * MAP_SCALE);
+            steeringBuffers.assign(4 * count, 0.f);
+            for (int i = 0; i < 2 * count; i++)
+                steeringBuffers[i] = pos(gen);
+            measure("steering", count, minSeconds, scene,
+                    [&steeringBuffers](Scene& s) { return steeringPass(s, steeringBuffers); });
+        }
+        // flow field and EnemyPool::tick, level of detail included
+        if (wanted("enemy_tick"))
+            measure("enemy_tick", count, minSeconds, scene, enemyTickPass);
+        if (wanted("enemy_tick_jobs"))
+        {
+            scene.world->setJobSystem(&jobs);
+            measure("enemy_tick_jobs", count, minSeconds, scene, enemyTickPass);
+            scene.world->setJobSystem(nullptr);
+        }
+        if (wanted("collision"))
+            measure("collision", count, minSeconds, scene, collisionPass);
+        if (wanted("weapon_sweep"))
+            measure("weapon_sweep", count, minSeconds, scene, weaponSweepPass);
+        if (wanted("draw_list"))
+        {
+            scene.restore();
+            measure("draw_list", count, minSeconds, scene,
+                    [&renderer](Scene& s) { return drawListPass(s, renderer); });
+        }
+        // last: it leaves the World without the scene's enemies
+        if (wanted("spawn_despawn"))
+            measure("spawn_despawn", count, minSeconds, scene,
+                    [count, &spawned](Scene& s) { return spawnDespawnPass(s, count, spawned); });
+    }
+    return 0;
+}
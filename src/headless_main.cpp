@@ -0,0 +1,135 @@
+#include "World.h"
+#include "JobSystem.h"
+#include "Timing.h"
+#include "InputRecording.h"
+#include "Profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+// Window-less driver for the simulation core: no window, GPU or audio
+// device, no frame cap. Used for soak and load testing on CI machines.
+//   usage: Arachisya_headless [steps] [seed] [threads]
+//          Arachisya_headless --replay file [threads]
+// threads defaults to every hardware thread; results are the same for any count.
+// --replay plays a session recorded with `Arachisya --record file` at full
+// speed; profiler builds also write its trace to profile_trace.json
+
+// Scripted player: walks in a slowly changing direction and swings the
+// sword twice a second, so enemies keep spawning, chasing and dying.
+static WorldInput botInput(long stepIndex)
+{
+    static const unsigned directions[8]{
+        INPUT_RIGHT, INPUT_RIGHT | INPUT_DOWN, INPUT_DOWN, INPUT_DOWN | INPUT_LEFT,
+        INPUT_LEFT, INPUT_LEFT | INPUT_UP, INPUT_UP, INPUT_UP | INPUT_RIGHT};
+
+    WorldInput input{};
+    input.held = directions[(stepIndex / 180) % 8];
+    if (stepIndex % 60 == 0)
+    {
+        input.held |= INPUT_ATTACK;
+        input.pressed |= INPUT_ATTACK;
+    }
+    return input;
+}
+
+// Replays a recorded session into a World built the same way, one profiler
+// frame per step. Stops where the game stopped stepping (end screen) or
+// where the recording ends.
+static int runReplay(const char* path, int threads)
+{
+    InputPlayer replay;
+    if (!replay.open(path))
+    {
+        std::fprintf(stderr, "%s is not a recording\n", path);
+        return 1;
+    }
+
+    JobSystem jobs(threads > 0 ? threads - 1 : -1);
+    World world(replay.getViewWidth(), replay.getViewHeight(), replay.getSeed());
+    world.setJobSystem(&jobs);
+
+#if defined(ENABLE_PROFILER)
+    Profiler::get().start();
+#endif
+    long killed{};
+    WorldInput input{};
+    auto start = std::chrono::steady_clock::now();
+    while (!world.isGameOver() && !world.isVictory() && replay.next(input))
+    {
+#if defined(ENABLE_PROFILER)
+        Profiler::get().beginFrame();
+#endif
+        world.step(FIXED_TIME_STEP, input);
+        killed += world.getEvents().enemiesKilled;
+#if defined(ENABLE_PROFILER)
+        Profiler::get().endFrame();
+#endif
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+#if defined(ENABLE_PROFILER)
+    Profiler::get().stop();
+    Profiler::get().writeTrace("profile_trace.json");
+#endif
+
+    std::printf("seed       %u\n", replay.getSeed());
+    std::printf("steps      %ld\n", replay.getStep());
+    std::printf("seconds    %.3f\n", seconds);
+    std::printf("steps/sec  %.0f\n", seconds > 0.0 ? replay.getStep() / seconds : 0.0);
+    std::printf("threads    %d\n", jobs.getThreadCount());
+    std::printf("killed     %ld\n", killed);
+    std::printf("enemies    %d\n", world.getEnemies().size());
+    std::printf("health     %.2f\n", world.getKnight().getHealth());
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 2 && std::strcmp(argv[1], "--replay") == 0)
+        return runReplay(argv[2], argc > 3 ? std::atoi(argv[3]) : 0);
+
+    const int windowWidth{682};
+    const int windowHeight{576};
+
+    long steps = argc > 1 ? std::atol(argv[1]) : 100000;
+    unsigned int seed = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : 1u;
+    int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+
+    JobSystem jobs(threads > 0 ? threads - 1 : -1);
+    auto world = std::make_unique<World>(windowWidth, windowHeight, seed);
+    world->setJobSystem(&jobs);
+
+    long killed{};
+    long restarts{};
+    long stepIndex{};
+    auto start = std::chrono::steady_clock::now();
+    for (; stepIndex < steps; ++stepIndex)
+    {
+        world->step(FIXED_TIME_STEP, botInput(stepIndex));
+        killed += world->getEvents().enemiesKilled;
+
+        // keep soaking: start a new round from the next seed
+        if (world->isGameOver() || world->isVictory())
+        {
+            ++restarts;
+            world = std::make_unique<World>(windowWidth, windowHeight, seed + restarts);
+            world->setJobSystem(&jobs);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::printf("steps      %ld\n", stepIndex);
+    std::printf("seconds    %.3f\n", seconds);
+    std::printf("steps/sec  %.0f\n", seconds > 0.0 ? stepIndex / seconds : 0.0);
+    std::printf("threads    %d\n", jobs.getThreadCount());
+    std::printf("restarts   %ld\n", restarts);
+    std::printf("killed     %ld\n", killed);
+    std::printf("enemies    %d\n", world->getEnemies().size());
+    std::printf("awake      %d\n", world->getEnemies().getAwakeCount());
+    std::printf("health     %.2f\n", world->getKnight().getHealth());
+    return 0;
+}
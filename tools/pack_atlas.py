@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""Pack sprite PNGs into a single atlas texture.
+
+Writes the atlas image plus a C++ header with one source Rectangle per
+input file, so the game can draw every sprite from one texture.
+Only the Python standard library is used (emsdk ships a Python).
+
+usage: pack_atlas.py <atlas.png> <header.h> <sprite.png>...
+"""
+
+import os
+import re
+import struct
+import sys
+import zlib
+
+PADDING = 1  # transparent pixels between sprites, avoids bleeding when scaled
+
+
+def read_png(path):
+    """Decode an 8-bit, non-interlaced PNG into (width, height, RGBA bytes)."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s: not a PNG file' % path)
+
+    pos = 8
+    idat = b''
+    palette = b''
+    alpha = b''
+    width = height = color_type = 0
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            width, height, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+            if depth != 8 or interlace != 0:
+                raise ValueError('%s: only 8-bit non-interlaced PNGs are supported' % path)
+        elif kind == b'PLTE':
+            palette = chunk
+        elif kind == b'tRNS':
+            alpha = chunk
+        elif kind == b'IDAT':
+            idat += chunk
+        elif kind == b'IEND':
+            break
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    stride = width * channels
+    raw = zlib.decompress(idat)
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        kind = raw[start]
+        row = bytearray(raw[start + 1:start + 1 + stride])
+        for x in range(stride):
+            a = row[x - channels] if x >= channels else 0
+            b = prev[x]
+            c = prev[x - channels] if x >= channels else 0
+            if kind == 1:
+                row[x] = (row[x] + a) & 0xFF
+            elif kind == 2:
+                row[x] = (row[x] + b) & 0xFF
+            elif kind == 3:
+                row[x] = (row[x] + ((a + b) >> 1)) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                row[x] = (row[x] + pred) & 0xFF
+        rows.append(row)
+        prev = row
+
+    rgba = bytearray()
+    for row in rows:
+        for x in range(width):
+            px = row[x * channels:(x + 1) * channels]
+            if color_type == 6:
+                rgba += px
+            elif color_type == 2:
+                rgba += px + b'\xff'
+            elif color_type == 4:
+                rgba += bytes((px[0], px[0], px[0], px[1]))
+            elif color_type == 0:
+                rgba += bytes((px[0], px[0], px[0], 255))
+            else:
+                i = px[0]
+                rgba += palette[i * 3:i * 3 + 3] + bytes((alpha[i] if i < len(alpha) else 255,))
+    return width, height, bytes(rgba)
+
+
+def write_png(path, width, height, rgba):
+    def chunk(kind, body):
+        return struct.pack('>I', len(body)) + kind + body + struct.pack('>I', zlib.crc32(kind + body) & 0xFFFFFFFF)
+
+    stride = width * 4
+    raw = b''.join(b'\x00' + rgba[y * stride:(y + 1) * stride] for y in range(height))
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 6, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(raw, 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+def symbol_name(path):
+    """IntellectDevourerIdleSide_spritesheet.png -> INTELLECT_DEVOURER_IDLE_SIDE"""
+    name = os.path.splitext(os.path.basename(path))[0]
+    name = re.sub(r'_spritesheet$', '', name)
+    name = re.sub(r'([a-z0-9])([A-Z])', r'\1_\2', name)
+    return re.sub(r'[^A-Za-z0-9]+', '_', name).upper()
+
+
+def next_pow2(value):
+    size = 1
+    while size < value:
+        size *= 2
+    return size
+
+
+def shelf_pack(sprites, atlas_width):
+    """Place sprites (tallest first) left to right in rows. Returns height or None."""
+    x = y = shelf = 0
+    for sprite in sprites:
+        w, h = sprite['width'] + PADDING, sprite['height'] + PADDING
+        if w > atlas_width:
+            return None
+        if x + w > atlas_width:
+            x, y, shelf = 0, y + shelf, 0
+        sprite['x'], sprite['y'] = x, y
+        x += w
+        shelf = max(shelf, h)
+    return y + shelf
+
+
+def main(argv):
+    if len(argv) < 4:
+        sys.stderr.write(__doc__)
+        return 1
+    image_path, header_path, inputs = argv[1], argv[2], sorted(set(argv[3:]))
+
+    sprites = []
+    for path in inputs:
+        width, height, pixels = read_png(path)
+        sprites.append({'path': path.replace('\\', '/'), 'name': symbol_name(path),
+                        'width': width, 'height': height, 'pixels': pixels})
+    sprites.sort(key=lambda s: (-s['height'], -s['width'], s['name']))
+
+    # smallest power of two square-ish atlas that fits everything
+    atlas_width = next_pow2(max(s['width'] for s in sprites) + PADDING)
+    while True:
+        used = shelf_pack(sprites, atlas_width)
+        if used is not None and next_pow2(used) <= atlas_width:
+            break
+        atlas_width *= 2
+    atlas_height = next_pow2(used)
+
+    atlas = bytearray(atlas_width * atlas_height * 4)
+    for s in sprites:
+        for row in range(s['height']):
+            src = s['pixels'][row * s['width'] * 4:(row + 1) * s['width'] * 4]
+            dst = ((s['y'] + row) * atlas_width + s['x']) * 4
+            atlas[dst:dst + len(src)] = src
+
+    image_dir = os.path.dirname(image_path)
+    if image_dir and not os.path.isdir(image_dir):
+        os.makedirs(image_dir)
+    write_png(image_path, atlas_width, atlas_height, bytes(atlas))
+
+    lines = [
+        '// Generated by tools/pack_atlas.py, do not edit. Run `make atlas` instead.',
+        '// Source rects of every sprite packed into %s.' % image_path.replace('\\', '/'),
+        '#ifndef ATLAS_DATA_H',
+        '#define ATLAS_DATA_H',
+        '',
+        '#include "raylib.h"',
+        '',
+        '#define ATLAS_IMAGE_PATH "%s"' % image_path.replace('\\', '/'),
+        'const int ATLAS_WIDTH{%d};' % atlas_width,
+        'const int ATLAS_HEIGHT{%d};' % atlas_height,
+        '',
+    ]
+    for s in sorted(sprites, key=lambda s: s['name']):
+        lines.append('const Rectangle ATLAS_%s{%d.f, %d.f, %d.f, %d.f}; // %s' % (
+            s['name'], s['x'], s['y'], s['width'], s['height'], s['path']))
+    lines += ['', '#endif', '']
+    with open(header_path, 'w', newline='\n') as f:
+        f.write('\n'.join(lines))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))